@@ -0,0 +1,68 @@
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "KronosXPredict/ipc.hpp"
+
+// Hosts models for other local processes over shared memory.
+//
+// Usage: kronos_predict_server <socket_path> <config.json>
+//
+// config.json:
+//   { "models": [ { "name": "stub",
+//                   "plugin": "plugins/stub/libKronosXPredict_stub.so",
+//                   "config": { "warmup_count": 2 } } ] }
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void on_signal(int) { g_stop = 1; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace KronosXPredict;
+
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <socket_path> <config.json>\n";
+        return 2;
+    }
+
+    try {
+        std::ifstream in(argv[2]);
+        if (!in) {
+            std::cerr << "cannot open config file " << argv[2] << "\n";
+            return 2;
+        }
+        json cfg = json::parse(in);
+
+        IpcServer server(argv[1]);
+        for (const auto& m : cfg.at("models")) {
+            const std::string name = m.at("name").get<std::string>();
+            auto lib   = load_plugin_library(m.at("plugin").get<std::string>());
+            auto model = lib->create_realtime(m.value("config", json::object()));
+            server.add_model(name, std::make_shared<RealtimeModelInstance>(lib, std::move(model)));
+            std::cout << "hosting model '" << name << "'\n";
+        }
+
+        std::signal(SIGINT, on_signal);
+        std::signal(SIGTERM, on_signal);
+
+        server.start();
+        std::cout << "listening on " << server.socket_path() << std::endl;
+        while (!g_stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        server.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "kronos_predict_server: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
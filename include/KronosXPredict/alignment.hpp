@@ -0,0 +1,115 @@
+#pragma once
+
+#include "KronosXPredict/api.hpp"
+
+#include <fstream>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace KronosXPredict {
+
+class AlignmentError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// One update from one input feed.
+struct StreamEvent {
+    TimePoint             t;
+    std::span<const Real> values;
+};
+
+// Timestamp-ordered replay source. `out.values` stays valid until the next call.
+class IEventSource {
+public:
+    virtual ~IEventSource() = default;
+    virtual bool next(StreamEvent& out) = 0; // false when exhausted
+};
+
+// Recorded feed: one event per line, "t,v0,v1,...", where t is the
+// TimePoint::time_since_epoch() count. Blank lines and lines starting with '#'
+// are skipped. Every line must carry the same number of values; anything other
+// than trailing whitespace after a number is an error.
+class CsvEventSource : public IEventSource {
+public:
+    explicit CsvEventSource(const std::string& path);
+
+    bool next(StreamEvent& out) override;
+
+private:
+    std::string       path_;
+    std::ifstream     in_;
+    std::string       line_;
+    std::vector<Real> values_;
+    std::size_t       width_ = 0;
+    std::size_t       line_no_ = 0;
+};
+
+enum class ColumnBlock { Endogenous, Exogenous };
+
+// Where a stream's values land in the aligned Observation.
+struct StreamLayout {
+    std::size_t width;
+    ColumnBlock block  = ColumnBlock::Endogenous;
+    std::size_t offset = 0; // first column within the block
+};
+
+enum class AlignTrigger {
+    AnyUpdate, // emit after every event
+    Stream,    // emit after events from `trigger_stream`
+    Grid       // emit at origin + k * grid_step, as of that instant
+};
+
+struct AlignerConfig {
+    AlignTrigger    trigger        = AlignTrigger::AnyUpdate;
+    std::size_t     trigger_stream = 0;
+    Clock::duration grid_step      {};
+    TimePoint       grid_origin    {};
+    bool            require_all    = true; // hold emissions until every stream has a value
+};
+
+// Maintains last-value (as-of) state per column across N streams and emits
+// aligned Observations. The Observation handed to the sink points into buffers
+// owned by the aligner and is only valid during the callback.
+//
+// Live use: call on_event() in arrival order from one thread (and advance_to()
+// from a timer for grid triggers). Replay: replay() k-way merges the sources.
+class AsOfAligner {
+public:
+    using Sink = std::function<void(const Observation&)>;
+
+    AsOfAligner(std::vector<StreamLayout> streams, AlignerConfig cfg = {});
+
+    std::size_t dim_endogenous() const noexcept { return endogenous_.size(); }
+    std::size_t dim_exogenous()  const noexcept { return exogenous_.size(); }
+
+    void on_event(std::size_t stream, TimePoint t, std::span<const Real> values,
+                  const Sink& sink);
+
+    // Grid trigger: emits every pending grid point <= now.
+    void advance_to(TimePoint now, const Sink& sink);
+
+    // Merges one source per stream (sources[i] feeds stream i) in timestamp
+    // order; ties go to the lower stream index. Grid points up to and including
+    // the last event are emitted. Returns the number of events.
+    std::size_t replay(std::span<IEventSource* const> sources, const Sink& sink);
+
+private:
+    void emit(TimePoint t, const Sink& sink);
+    void emit_grid_before(TimePoint t, const Sink& sink, bool inclusive);
+
+    std::vector<StreamLayout> streams_;
+    AlignerConfig             cfg_;
+    std::vector<Real>         endogenous_;
+    std::vector<Real>         exogenous_;
+    std::vector<bool>         seen_;
+    std::size_t               missing_;
+    TimePoint                 last_t_{};
+    TimePoint                 next_grid_{};
+    bool                      started_ = false;
+};
+
+} // namespace KronosXPredict
@@ -2,10 +2,12 @@
 
 #include <chrono>
 #include <cstddef>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace KronosXPredict {
@@ -44,15 +46,50 @@ struct PredictionRequest {
     TargetKind  target_kind;
     int         steps_ahead      = 1;
     bool        want_uncertainty = true;
+    // Where the model should allocate the PredictionResult. The caller owns
+    // this choice because it owns the result's lifetime.
+    std::pmr::memory_resource* result_resource = std::pmr::get_default_resource();
 };
 
 struct PredictionResult {
-    TimePoint                        based_on;
-    TargetKind                       target_kind;
-    int                              steps_ahead;
-    std::vector<Real>                mean;
-    std::optional<std::vector<Real>> variance;
-    std::unordered_map<std::string, Real> scalars;
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    PredictionResult() = default;
+    explicit PredictionResult(const allocator_type& alloc)
+        : mean(alloc), scalars(alloc) {}
+
+    PredictionResult(const PredictionResult&) = default;
+    PredictionResult(PredictionResult&&) = default;
+    PredictionResult& operator=(const PredictionResult&) = default;
+    PredictionResult& operator=(PredictionResult&&) = default;
+
+    // Allocator-extended copy/move, used by pmr containers of results.
+    PredictionResult(const PredictionResult& other, const allocator_type& alloc)
+        : based_on(other.based_on), target_kind(other.target_kind),
+          steps_ahead(other.steps_ahead), mean(other.mean, alloc),
+          scalars(other.scalars, alloc) {
+        if (other.variance) variance.emplace(*other.variance, alloc);
+    }
+    PredictionResult(PredictionResult&& other, const allocator_type& alloc)
+        : based_on(other.based_on), target_kind(other.target_kind),
+          steps_ahead(other.steps_ahead), mean(std::move(other.mean), alloc),
+          scalars(std::move(other.scalars), alloc) {
+        if (other.variance) variance.emplace(std::move(*other.variance), alloc);
+    }
+
+    allocator_type get_allocator() const { return mean.get_allocator(); }
+
+    // Engages `variance` with n copies of `value`, allocated like `mean`.
+    std::pmr::vector<Real>& emplace_variance(std::size_t n, Real value = 0.0) {
+        return variance.emplace(n, value, mean.get_allocator());
+    }
+
+    TimePoint                                  based_on{};
+    TargetKind                                 target_kind{};
+    int                                        steps_ahead = 0;
+    std::pmr::vector<Real>                     mean;
+    std::optional<std::pmr::vector<Real>>      variance; // set via emplace_variance()
+    std::pmr::unordered_map<std::pmr::string, Real> scalars;
 };
 
 enum class ModelKind {
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "KronosXPredict/plugin_loader.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace KronosXPredict {
+
+class FeatureError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class FeatureOp {
+    LogReturn,  // log(x_t / x_{t-1})
+    Diff,       // x_t - x_{t-1}
+    ZScore,     // (x_t - mean) / stddev over the last `window` inputs
+    RollingVol, // stddev over the last `window` inputs
+    Lag         // [x_t, x_{t-1}, ..., x_{t-window}] per column (widens the row)
+};
+
+struct FeatureStageSpec {
+    FeatureOp   op;
+    std::size_t window = 1; // rolling window, or number of lags for Lag
+};
+
+// Incremental transform chain over one block (endogenous or exogenous).
+//
+// Buffers are sized on the first push and reused afterwards. Runs of
+// elementwise stages are fused: each column is taken through every stage of the
+// run in a single pass over the row.
+class FeatureChain {
+public:
+    explicit FeatureChain(std::vector<FeatureStageSpec> stages);
+
+    // Feeds one input row. Returns the output row, or an empty span while the
+    // chain is still warming up.
+    std::span<const Real> push(std::span<const Real> in);
+
+    bool ready() const noexcept { return ready_; }
+    void reset();
+
+private:
+    struct Stage {
+        FeatureStageSpec  spec;
+        std::size_t       in_width  = 0;
+        std::size_t       out_width = 0;
+        std::size_t       warmup    = 0; // inputs consumed before the first valid output
+        std::size_t       seen      = 0;
+        std::size_t       pos       = 0; // ring write slot
+        std::vector<Real> prev;          // LogReturn/Diff: last input per column
+        std::vector<Real> ring;          // ZScore/RollingVol/Lag: history, slot-major
+        std::vector<Real> sum;
+        std::vector<Real> sumsq;
+    };
+
+    // A run of adjacent elementwise stages, or a single Lag stage.
+    struct Segment {
+        std::size_t       first;
+        std::size_t       last; // exclusive
+        bool              fused;
+        std::vector<Real> out;
+    };
+
+    void allocate(std::size_t width);
+    static Real step(Stage& s, std::size_t j, Real v);
+    static void advance(Stage& s);
+
+    std::vector<Stage>   stages_;
+    std::vector<Segment> segments_;
+    std::vector<Real>    passthrough_; // copy of the input when there are no stages
+    std::size_t          width_ = 0;
+    bool                 allocated_ = false;
+    bool                 ready_ = false;
+};
+
+// Receives every row a FeaturePipeline produces, in order.
+class IFeatureSubscriber {
+public:
+    virtual ~IFeatureSubscriber() = default;
+    virtual void on_features(const Observation& row) = 0;
+};
+
+// Feature transforms declared in a model config:
+//
+//   "features": {
+//     "instrument": "ESZ5",
+//     "endogenous": [ {"op": "log_return"}, {"op": "zscore", "window": 50} ],
+//     "exogenous":  [ {"op": "lag", "window": 2} ]
+//   }
+//
+// A missing block passes its data through unchanged. "instrument" is required:
+// it keeps pipelines of different instruments apart when their transforms match.
+//
+// The pipeline is driven once per tick by the instrument feed via push(), which
+// hands each feature row to every subscriber.
+class FeaturePipeline {
+public:
+    FeaturePipeline(std::vector<FeatureStageSpec> endogenous,
+                    std::vector<FeatureStageSpec> exogenous);
+
+    static std::shared_ptr<FeaturePipeline> from_json(const json& spec);
+
+    // Transforms one tick of raw data and, once warmed up, delivers the row to
+    // every subscriber before returning. `seq` identifies the tick and must
+    // increase from one push to the next; a tick that is not newer than the last
+    // one is ignored and false is returned. Timestamps may repeat. Thread-safe;
+    // concurrent pushes are delivered one at a time.
+    bool push(std::uint64_t seq, const Observation& obs);
+
+    void subscribe(IFeatureSubscriber* sub);
+    void unsubscribe(IFeatureSubscriber* sub);
+
+    bool ready() const noexcept { return ready_.load(std::memory_order_acquire); }
+
+    // Ticks transformed since construction.
+    std::uint64_t computed() const noexcept { return computed_.load(std::memory_order_relaxed); }
+
+    void reset();
+
+private:
+    mutable std::mutex                mutex_;
+    FeatureChain                      endogenous_;
+    FeatureChain                      exogenous_;
+    std::vector<IFeatureSubscriber*>  subscribers_;
+    std::uint64_t                     last_seq_ = 0;
+    bool                              have_seq_ = false;
+    std::atomic<bool>                 ready_{false};
+    std::atomic<std::uint64_t>        computed_{0};
+};
+
+// Hands out one FeaturePipeline per (instrument, spec) so that models on the
+// same instrument share the computation.
+class FeaturePipelineRegistry {
+public:
+    std::shared_ptr<FeaturePipeline> acquire(const json& spec);
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<FeaturePipeline>> pipelines_;
+};
+
+// Wraps `inner` and subscribes it to `pipeline`, so that it sees every feature
+// row in order. Rows arrive from the thread calling FeaturePipeline::push; the
+// wrapper serializes them with predict(). Raw data must go to the pipeline:
+// ingest() on the wrapper throws FeatureError. reset() resets the inner model
+// only, since the pipeline may be shared.
+std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
+make_featured_model(std::unique_ptr<IRealtimeModel, RealtimeDestroyFn> inner,
+                    std::shared_ptr<FeaturePipeline> pipeline);
+
+// PluginLibrary::create_realtime, plus the "features" block of cfg if present.
+// The shared pipeline is registry.acquire(cfg["features"]).
+std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
+create_realtime_with_features(const PluginLibrary& lib, const json& cfg,
+                              FeaturePipelineRegistry& registry);
+
+} // namespace KronosXPredict
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "KronosXPredict/plugin_loader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace KronosXPredict {
+
+// Local multi-process prediction transport (Linux).
+//
+// A server process hosts named models. A client connects over a Unix-domain
+// socket (control only) and is handed a POSIX shared-memory segment holding two
+// single-producer/single-consumer rings: requests (client -> server) and
+// responses (server -> client). The data path never touches the socket; each
+// side spins on its ring, so round trips stay in the microsecond range.
+//
+// Handshake: "OPEN <model>" -> "OK <shm name>" -> "MAPPED". The server unlinks
+// the segment name as soon as the client has mapped it, so no name outlives a
+// crashed process.
+
+class IpcError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+inline constexpr std::uint32_t IPC_MAGIC      = 0x4B585031; // "KXP1"
+inline constexpr std::uint32_t IPC_VERSION    = 3;
+inline constexpr std::size_t   IPC_MAX_VALUES = 64;  // per-message endogenous + exogenous
+inline constexpr std::size_t   IPC_MAX_SCALARS = 16; // PredictionResult::scalars entries
+inline constexpr std::size_t   IPC_SCALAR_KEY  = 32; // key bytes, including the terminator
+inline constexpr std::size_t   IPC_RING_SLOTS = 256; // power of two
+
+enum class IpcMessageKind : std::uint32_t {
+    Ingest  = 1, // no response
+    Predict = 2,
+    Ready   = 3
+};
+
+enum class IpcStatus : std::uint32_t {
+    Ok    = 0,
+    Error = 1
+};
+
+struct IpcRequest {
+    std::uint64_t  seq;
+    IpcMessageKind kind;
+    std::int32_t   target_kind;
+    std::int32_t   steps_ahead;
+    std::uint32_t  want_uncertainty;
+    std::int64_t   t;            // TimePoint::time_since_epoch().count()
+    std::uint32_t  n_endogenous;
+    std::uint32_t  n_exogenous;
+    Real           values[IPC_MAX_VALUES]; // endogenous followed by exogenous
+};
+
+struct IpcScalar {
+    char key[IPC_SCALAR_KEY];
+    Real value;
+};
+
+// Results that do not fit (too many values or scalars, a key that is too long,
+// a variance whose size differs from the mean) are answered with an error
+// rather than truncated.
+struct IpcResponse {
+    std::uint64_t seq;
+    IpcStatus     status;
+    std::uint32_t ready;
+    std::int32_t  target_kind;
+    std::int32_t  steps_ahead;
+    std::int64_t  based_on;
+    std::uint32_t n;
+    std::uint32_t has_variance;
+    Real          mean[IPC_MAX_VALUES];
+    Real          variance[IPC_MAX_VALUES];
+    std::uint32_t n_scalars;
+    IpcScalar     scalars[IPC_MAX_SCALARS];
+    char          error[128];
+};
+
+// Lock-free SPSC ring living in shared memory. Indices increase monotonically;
+// slot = index % N.
+template <typename T, std::size_t N>
+struct IpcRing {
+    static_assert((N & (N - 1)) == 0, "IpcRing size must be a power of two");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "IpcRing requires address-free 64-bit atomics");
+
+    alignas(64) std::atomic<std::uint64_t> head{0}; // next slot to write
+    alignas(64) std::atomic<std::uint64_t> tail{0}; // next slot to read
+    alignas(64) T slots[N];
+
+    // Producer side: returns a slot to fill, or nullptr if full.
+    T* begin_push() noexcept {
+        const auto h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) return nullptr;
+        return &slots[h & (N - 1)];
+    }
+    void commit_push() noexcept {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer side: returns the oldest slot, or nullptr if empty.
+    const T* front() noexcept {
+        const auto t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return nullptr;
+        return &slots[t & (N - 1)];
+    }
+    void pop() noexcept {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+struct IpcSegment {
+    std::atomic<std::uint32_t> magic{0};
+    std::uint32_t              version = IPC_VERSION;
+    std::atomic<std::uint32_t> closed{0}; // set by the server when the session ends
+    IpcRing<IpcRequest,  IPC_RING_SLOTS> requests;
+    IpcRing<IpcResponse, IPC_RING_SLOTS> responses;
+};
+
+// Thin client for one hosted model. Not thread-safe: each thread (or process)
+// that talks to the server should own its own IpcClient.
+class IpcClient {
+public:
+    IpcClient(const std::string& socket_path, const std::string& model,
+              std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+    ~IpcClient();
+
+    IpcClient(const IpcClient&) = delete;
+    IpcClient& operator=(const IpcClient&) = delete;
+
+    void ingest(const Observation& obs);
+    bool ready();
+    PredictionResult predict(const PredictionRequest& req);
+
+private:
+    IpcRequest&        next_request();
+    const IpcResponse& await_response(std::uint64_t seq);
+
+    int                       fd_  = -1;
+    IpcSegment*               seg_ = nullptr;
+    std::uint64_t             seq_ = 0;
+    std::chrono::milliseconds timeout_;
+};
+
+struct IpcServerOptions {
+    // Empty polls on a session's request ring before the worker starts yielding.
+    // Spinning only pays off when client and server can run on separate cores.
+    std::size_t spin_before_yield = std::thread::hardware_concurrency() > 1 ? 100000 : 0;
+    // Further empty polls spent yielding before the worker falls back to
+    // sleeping between polls. Yielding keeps a waiting client on the same core
+    // within a context switch of its answer.
+    std::size_t yield_before_sleep = 200000;
+};
+
+class IpcServer {
+public:
+    explicit IpcServer(std::string socket_path, IpcServerOptions opts = {});
+    ~IpcServer();
+
+    IpcServer(const IpcServer&) = delete;
+    IpcServer& operator=(const IpcServer&) = delete;
+
+    // Models must be added before start(). All sessions attached to one name
+    // share the same instance.
+    void add_model(const std::string& name, std::shared_ptr<RealtimeModelInstance> instance);
+
+    void start();
+    void stop();
+
+    const std::string& socket_path() const { return socket_path_; }
+
+private:
+    struct HostedModel {
+        std::shared_ptr<RealtimeModelInstance> instance;
+        std::mutex                             mutex;
+    };
+
+    struct Session {
+        int               fd  = -1;
+        std::string       shm_name;
+        bool              unlinked = false;
+        IpcSegment*       seg = nullptr;
+        HostedModel*      model = nullptr;
+        std::string       pending_error; // deferred ingest failure
+        std::atomic<bool> done{false};
+        std::thread       worker;
+    };
+
+    void accept_loop();
+    void run_session(Session& s);  // handshake, then serve
+    void open_session(Session& s);
+    void serve(Session& s);
+    void handle(Session& s, const IpcRequest& req);
+    void reap(bool all);
+
+    std::string       socket_path_;
+    IpcServerOptions  opts_;
+    int               listen_fd_ = -1;
+    std::atomic<bool> stopping_{false};
+    std::thread       acceptor_;
+    std::uint64_t     next_session_ = 0;
+
+    std::unordered_map<std::string, std::unique_ptr<HostedModel>> models_;
+    std::list<Session> sessions_; // list owned by the acceptor; each entry by its worker until done
+};
+
+} // namespace KronosXPredict
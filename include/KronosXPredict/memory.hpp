@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace KronosXPredict {
+
+struct ArenaOptions {
+    std::size_t initial_bytes = std::size_t{1} << 20;
+    int         numa_node     = -1;    // -1: first-touch from the constructing thread
+    bool        synchronized  = false; // true if several threads allocate from the arena
+};
+
+// Per-shard memory arena for model instances.
+//
+// One pre-faulted region backs a monotonic buffer, with a pool on top so that
+// memory freed by a model is reused inside the shard instead of going back to
+// the global heap. Pass resource() to PluginLibrary::create_realtime for every
+// model of the shard; destroying the arena releases the whole shard at once
+// (all models allocated from it must be destroyed first).
+//
+// On Linux the region is bound to `numa_node` when set. Otherwise pages are
+// touched by the constructing thread, so build the arena on a thread already
+// running on the shard's node.
+class ModelArena {
+public:
+    explicit ModelArena(ArenaOptions opts = {});
+    ~ModelArena();
+
+    ModelArena(const ModelArena&) = delete;
+    ModelArena& operator=(const ModelArena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return pool_.get(); }
+
+    std::size_t region_bytes() const noexcept { return region_size_; }
+
+    // True if `p` lies in the pre-faulted region (false once the arena has
+    // spilled to the upstream heap for it).
+    bool contains(const void* p) const noexcept {
+        auto* b = static_cast<const std::byte*>(region_);
+        auto* q = static_cast<const std::byte*>(p);
+        return q >= b && q < b + region_size_;
+    }
+
+private:
+    void*                                      region_ = nullptr;
+    std::size_t                                region_size_ = 0;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> monotonic_;
+    std::unique_ptr<std::pmr::memory_resource> pool_;
+};
+
+} // namespace KronosXPredict
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory_resource>
 #include <nlohmann/json_fwd.hpp>
 #include "KronosXPredict/runtime.hpp"
 #include "KronosXPredict/training.hpp"
@@ -8,14 +9,27 @@ namespace KronosXPredict {
 
 using json = nlohmann::json;
 
+// Bumped whenever the plugin-facing types or factory signatures change. Plugin
+// manifests declare the version they were built against; CMake reads this line
+// (KRONOSPREDICT_ABI_VERSION) when it generates them.
+inline constexpr int KP_ABI_VERSION = 1;
+
 inline constexpr const char* KP_RT_FACTORY_NAME  = "KronosXPredict_create_realtime_model";
 inline constexpr const char* KP_RT_DESTROY_NAME  = "KronosXPredict_destroy_realtime_model";
 inline constexpr const char* KP_TR_FACTORY_NAME  = "KronosXPredict_create_trainer";
 inline constexpr const char* KP_TR_DESTROY_NAME  = "KronosXPredict_destroy_trainer";
 
+// Optional: models whose object and state are allocated from a caller-provided
+// std::pmr::memory_resource (e.g. a per-shard ModelArena).
+inline constexpr const char* KP_RT_FACTORY_PMR_NAME = "KronosXPredict_create_realtime_model_pmr";
+inline constexpr const char* KP_RT_DESTROY_PMR_NAME = "KronosXPredict_destroy_realtime_model_pmr";
+
 using RealtimeFactoryFn = IRealtimeModel* (*)(const json& config);
 using RealtimeDestroyFn = void (*)(IRealtimeModel*);
 
+using RealtimeFactoryPmrFn = IRealtimeModel* (*)(const json& config,
+                                                 std::pmr::memory_resource* mr);
+
 using TrainerFactoryFn  = IModelTrainer* (*)(const json& config);
 using TrainerDestroyFn  = void (*)(IModelTrainer*);
 
@@ -26,6 +26,11 @@ public:
     std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
     create_realtime(const json& cfg) const;
 
+    // Allocates the model from `mr` when the plugin exports the pmr factory;
+    // otherwise falls back to create_realtime(cfg).
+    std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
+    create_realtime(const json& cfg, std::pmr::memory_resource* mr) const;
+
     std::unique_ptr<IModelTrainer, TrainerDestroyFn>
     create_trainer(const json& cfg) const;
 
@@ -33,6 +38,8 @@ private:
     void*              handle_ = nullptr;
     RealtimeFactoryFn  rt_factory_ = nullptr;
     RealtimeDestroyFn  rt_destroy_ = nullptr;
+    RealtimeFactoryPmrFn rt_factory_pmr_ = nullptr;
+    RealtimeDestroyFn  rt_destroy_pmr_ = nullptr;
     TrainerFactoryFn   tr_factory_ = nullptr;
     TrainerDestroyFn   tr_destroy_ = nullptr;
 
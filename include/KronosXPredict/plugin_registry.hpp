@@ -0,0 +1,108 @@
+#pragma once
+
+#include "KronosXPredict/plugin_loader.hpp"
+#include <nlohmann/json.hpp>
+
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace KronosXPredict {
+
+// Parsed "<name>.manifest.json", which sits next to a plugin library:
+//
+//   { "name": "stub",
+//     "library": "libKronosXPredict_stub.so",   // relative to the manifest
+//     "abi_version": 1,
+//     "model_kinds": ["Custom"],
+//     "precision": "float64",
+//     "provides": ["realtime", "realtime_pmr", "trainer"] }
+//
+// "realtime_pmr" means the library exports the pmr realtime factory.
+struct PluginManifest {
+    std::string            name;
+    std::string            library; // absolute path
+    int                    abi_version = 0;
+    std::vector<ModelKind> model_kinds;
+    std::string            precision;
+    bool                   provides_realtime     = false;
+    bool                   provides_realtime_pmr = false;
+    bool                   provides_trainer      = false;
+
+    bool compatible() const noexcept { return abi_version == KP_ABI_VERSION; }
+};
+
+struct PluginScanResult {
+    std::size_t              registered = 0;
+    std::vector<std::string> errors; // "<manifest>: <reason>" for each skipped manifest
+};
+
+// One model to bring up at startup.
+struct ModelSpec {
+    std::string plugin; // manifest name, or a library path
+    json        config;
+    std::function<void(IRealtimeModel&)> warmup; // optional, e.g. replay history
+    // Optional, e.g. a ModelArena's resource(); passed to the pmr factory.
+    // Specs are created on several threads, so a resource shared between specs
+    // must be thread-safe (ArenaOptions::synchronized).
+    std::pmr::memory_resource* resource = nullptr;
+};
+
+struct StartupTimings {
+    Clock::duration load{};   // dlopen + symbol lookup of distinct libraries
+    Clock::duration create{}; // factory calls
+    Clock::duration warmup{}; // ModelSpec::warmup calls
+    Clock::duration total{};
+};
+
+struct WarmStartResult {
+    std::vector<std::shared_ptr<RealtimeModelInstance>> instances; // per spec; null on failure
+    std::vector<std::string>                            errors;    // per spec; empty on success
+    StartupTimings                                      timings;
+};
+
+// Process-wide view of installed plugins and owner of loaded library handles.
+// load_plugin_library() goes through the same cache.
+class PluginRegistry {
+public:
+    static PluginRegistry& instance();
+
+    // Reads every *.manifest.json in `dir` without loading any library. A
+    // malformed manifest is skipped and reported; only an unreadable directory
+    // throws.
+    PluginScanResult scan(const std::string& dir);
+
+    // Drops a manifest. Libraries already loaded through it stay cached.
+    bool forget(const std::string& name);
+
+    std::vector<PluginManifest>   manifests() const;
+    std::optional<PluginManifest> find(const std::string& name) const;
+    std::vector<PluginManifest>   find_by_kind(ModelKind kind) const;
+
+    // Cached by canonical path; `plugin` may also be a manifest name. Manifests
+    // with an incompatible ABI version are refused before dlopen.
+    std::shared_ptr<PluginLibrary> library(const std::string& plugin);
+
+    // Loads, creates and warms up all specs on `threads` workers (0: one per
+    // hardware thread), phase by phase.
+    WarmStartResult warm_start(const std::vector<ModelSpec>& specs, unsigned threads = 0);
+
+    Clock::duration last_scan_duration() const;
+
+private:
+    PluginRegistry() = default;
+
+    std::string resolve(const std::string& plugin) const; // caller holds mutex_
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, PluginManifest>                 manifests_;
+    std::unordered_map<std::string, std::string>                    by_library_; // path -> name
+    std::unordered_map<std::string, std::shared_ptr<PluginLibrary>> libraries_;
+    Clock::duration                                                 last_scan_{};
+};
+
+} // namespace KronosXPredict
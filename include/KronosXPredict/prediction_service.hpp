@@ -0,0 +1,126 @@
+#pragma once
+
+#include "KronosXPredict/plugin_loader.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace KronosXPredict {
+
+// Thrown through a prediction future when the request could not be served
+// before its deadline (and no stale result was available) or the queue was full.
+class PredictionShed : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+struct PredictionServiceOptions {
+    std::size_t max_queue_depth = 1024;
+    bool        serve_stale     = true; // fall back to the last result for a missed deadline
+};
+
+struct PredictionServiceMetrics {
+    std::size_t   queue_depth = 0;
+    std::uint64_t submitted   = 0;
+    std::uint64_t computed    = 0; // calls that reached IRealtimeModel::predict
+    std::uint64_t coalesced   = 0; // requests answered by another request's computation
+    std::uint64_t served_stale = 0;
+    std::uint64_t shed        = 0;
+};
+
+// Asynchronous front-end over a RealtimeModelInstance.
+//
+// All access to the underlying model is serialized on a single worker thread,
+// so ingest() and submit() may be called from any number of threads. Requests
+// that are identical (same PredictionRequest fields) and target the same tick
+// share one computation. Each ingest() starts a new tick.
+//
+// A request that has no fresh result by its deadline is answered at the
+// deadline with the most recent result of the same shape (marked with
+// scalars["stale"] = 1) when serve_stale is set, and shed otherwise. Deadlines
+// are enforced by a timer thread, so they hold while the worker is busy in
+// predict(). A request joining an in-flight computation with a later deadline
+// than its own is answered stale right away when a previous result exists.
+class PredictionService {
+public:
+    using Future = std::shared_future<PredictionResult>;
+
+    explicit PredictionService(std::shared_ptr<RealtimeModelInstance> instance,
+                               PredictionServiceOptions opts = {});
+    ~PredictionService();
+
+    PredictionService(const PredictionService&) = delete;
+    PredictionService& operator=(const PredictionService&) = delete;
+
+    // Forwards to IRealtimeModel::ingest and advances the tick.
+    void ingest(const Observation& obs);
+
+    bool ready() const;
+
+    Future submit(const PredictionRequest& req, TimePoint deadline);
+    Future submit(const PredictionRequest& req, Clock::duration budget) {
+        return submit(req, Clock::now() + budget);
+    }
+
+    PredictionServiceMetrics metrics() const;
+
+private:
+    using Shape = std::tuple<TargetKind, int, bool>;
+
+    struct Pending {
+        Shape                            shape;
+        std::uint64_t                    tick;
+        TimePoint                        deadline;
+        PredictionRequest                req;
+        std::promise<PredictionResult>   promise;
+        Future                           future;
+        bool                             done = false; // promise satisfied
+    };
+
+    struct Cached {
+        std::uint64_t    tick;
+        PredictionResult result;
+    };
+
+    static Shape shape_of(const PredictionRequest& req) {
+        return {req.target_kind, req.steps_ahead, req.want_uncertainty};
+    }
+
+    // The helpers below are called with mutex_ held.
+    void release(const Pending& p);
+    void fulfill(Pending& p, PredictionResult r);
+    void fail(Pending& p, std::exception_ptr e);
+    bool answer_fresh(Pending& p);  // from a result computed at or after p's tick
+    void expire(Pending& p);        // stale or shed
+
+    void run();
+    void expire_loop();
+
+    std::shared_ptr<RealtimeModelInstance> instance_;
+    PredictionServiceOptions               opts_;
+
+    mutable std::mutex       model_mutex_; // guards instance_->model()
+    mutable std::mutex       mutex_;       // guards everything below
+    std::condition_variable  cv_;       // worker: queue non-empty
+    std::condition_variable  timer_cv_; // expirer: new deadline
+    std::deque<std::shared_ptr<Pending>> queue_;
+    std::shared_ptr<Pending> current_;  // being computed by the worker
+    std::map<std::pair<Shape, std::uint64_t>, std::shared_ptr<Pending>> inflight_;
+    std::map<Shape, Cached>  cache_;
+    std::uint64_t            tick_ = 0;
+    bool                     stopping_ = false;
+    PredictionServiceMetrics metrics_;
+
+    std::thread worker_;
+    std::thread expirer_;
+};
+
+} // namespace KronosXPredict
@@ -2,10 +2,20 @@
 
 #include "KronosXPredict/api.hpp"
 #include <cstddef>
+#include <span>
+#include <stdexcept>
 #include <unordered_map>
 
 namespace KronosXPredict {
 
+class TrainingError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Opaque, trainer-defined checkpoint of incremental training state.
+using TrainerState = std::vector<std::byte>;
+
 struct TrainingMetrics {
     double loss           = 0.0;
     double log_likelihood = 0.0;
@@ -32,6 +42,29 @@ public:
                      const TrainingConfig& cfg) = 0;
     virtual ParameterBlob parameters() const = 0;
     virtual TrainingMetrics metrics() const = 0;
+
+    // Incremental training. A trainer that supports it folds each mini-batch
+    // into its sufficient statistics / optimizer state without revisiting
+    // earlier data, and parameters() reflects everything seen so far. fit()
+    // remains a full retrain from scratch.
+    virtual bool supports_partial_fit() const noexcept { return false; }
+
+    virtual void partial_fit(std::span<const TrainingSample> batch,
+                             const TrainingConfig& cfg) {
+        (void)batch;
+        (void)cfg;
+        throw TrainingError("Trainer does not support partial_fit");
+    }
+
+    // Checkpoint / restore the incremental state, e.g. between daily runs.
+    virtual TrainerState save_state() const {
+        throw TrainingError("Trainer does not support save_state");
+    }
+
+    virtual void load_state(const TrainerState& state) {
+        (void)state;
+        throw TrainingError("Trainer does not support load_state");
+    }
 };
 
 } // namespace KronosXPredict
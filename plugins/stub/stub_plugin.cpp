@@ -1,4 +1,6 @@
 #include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstring>
 #include "KronosXPredict/runtime.hpp"
 #include "KronosXPredict/training.hpp"
 #include "KronosXPredict/plugin.hpp"
@@ -7,8 +9,9 @@ namespace KronosXPredict {
 
 class StubRealtimeModel : public IRealtimeModel {
 public:
-    explicit StubRealtimeModel(const json& cfg)
-        : required_count_(cfg.value("warmup_count", 1)), count_(0) {}
+    explicit StubRealtimeModel(const json& cfg,
+                               std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : required_count_(cfg.value("warmup_count", 1)), count_(0), last_endogenous_(mr) {}
 
     void ingest(const Observation& obs) override {
         last_endogenous_.assign(obs.endogenous.begin(), obs.endogenous.end());
@@ -21,12 +24,12 @@ public:
     }
 
     PredictionResult predict(const PredictionRequest& req) const override {
-        PredictionResult r;
+        PredictionResult r(req.result_resource);
         r.based_on    = last_time_;
         r.target_kind = req.target_kind;
         r.steps_ahead = req.steps_ahead;
-        r.mean        = last_endogenous_;
-        r.variance    = std::vector<Real>(last_endogenous_.size(), 0.0);
+        r.mean.assign(last_endogenous_.begin(), last_endogenous_.end());
+        r.emplace_variance(last_endogenous_.size());
         r.scalars["count"] = static_cast<double>(count_);
         return r;
     }
@@ -40,11 +43,15 @@ public:
         return ModelKind::Custom;
     }
 
+    std::pmr::memory_resource* resource() const noexcept {
+        return last_endogenous_.get_allocator().resource();
+    }
+
 private:
     int required_count_;
     int count_;
     TimePoint last_time_{};
-    std::vector<Real> last_endogenous_;
+    std::pmr::vector<Real> last_endogenous_;
 };
 
 class StubTrainer : public IModelTrainer {
@@ -58,17 +65,65 @@ public:
             Observation{TimePoint{}, std::span<const Real>(), std::span<const Real>()},
             Target{std::span<const Real>(), TargetKind::Custom, 0}
         };
-        std::size_t n = 0;
+        count_ = 0;
+        sums_.clear();
         data.reset();
         while (data.next(s)) {
-            ++n;
+            accumulate(s);
         }
-        metrics_.scalars["samples_seen"] = static_cast<double>(n);
-        metrics_.loss = 0.0;
-        metrics_.log_likelihood = 0.0;
+        publish();
+    }
+
+    bool supports_partial_fit() const noexcept override {
+        return true;
+    }
 
-        params_.clear();
-        params_.push_back(std::byte{0});
+    void partial_fit(std::span<const TrainingSample> batch,
+                     const TrainingConfig&) override {
+        for (const auto& s : batch) {
+            accumulate(s);
+        }
+        publish();
+    }
+
+    // Layout: [magic (u32)][version (u32)][count (u64)][dim (u64)][sums (dim doubles)]
+    TrainerState save_state() const override {
+        const std::uint32_t tag[2] = {kStateMagic, kStateVersion};
+        const std::uint64_t header[2] = {count_, sums_.size()};
+        TrainerState state(sizeof(tag) + sizeof(header) + sums_.size() * sizeof(Real));
+        std::memcpy(state.data(), tag, sizeof(tag));
+        std::memcpy(state.data() + sizeof(tag), header, sizeof(header));
+        if (!sums_.empty()) {
+            std::memcpy(state.data() + sizeof(tag) + sizeof(header), sums_.data(),
+                        sums_.size() * sizeof(Real));
+        }
+        return state;
+    }
+
+    void load_state(const TrainerState& state) override {
+        std::uint32_t tag[2];
+        std::uint64_t header[2];
+        if (state.size() < sizeof(tag) + sizeof(header)) {
+            throw TrainingError("Stub trainer state is truncated");
+        }
+        std::memcpy(tag, state.data(), sizeof(tag));
+        if (tag[0] != kStateMagic) {
+            throw TrainingError("Not a stub trainer state");
+        }
+        if (tag[1] != kStateVersion) {
+            throw TrainingError("Unsupported stub trainer state version " + std::to_string(tag[1]));
+        }
+        std::memcpy(header, state.data() + sizeof(tag), sizeof(header));
+        if (state.size() != sizeof(tag) + sizeof(header) + header[1] * sizeof(Real)) {
+            throw TrainingError("Stub trainer state has the wrong size");
+        }
+        count_ = header[0];
+        sums_.resize(header[1]);
+        if (!sums_.empty()) {
+            std::memcpy(sums_.data(), state.data() + sizeof(tag) + sizeof(header),
+                        sums_.size() * sizeof(Real));
+        }
+        publish();
     }
 
     ParameterBlob parameters() const override {
@@ -80,9 +135,41 @@ public:
     }
 
 private:
-    json            cfg_;
-    ParameterBlob   params_;
-    TrainingMetrics metrics_;
+    static constexpr std::uint32_t kStateMagic   = 0x5453584B; // "KXST"
+    static constexpr std::uint32_t kStateVersion = 1;
+
+    // Sufficient statistics: sample count and per-column sums of y_t.
+    void accumulate(const TrainingSample& s) {
+        if (sums_.size() < s.obs.endogenous.size()) {
+            sums_.resize(s.obs.endogenous.size(), 0.0);
+        }
+        for (std::size_t i = 0; i < s.obs.endogenous.size(); ++i) {
+            sums_[i] += s.obs.endogenous[i];
+        }
+        ++count_;
+    }
+
+    // Parameters are the column means of y_t, as raw doubles.
+    void publish() {
+        metrics_.scalars["samples_seen"] = static_cast<double>(count_);
+        metrics_.loss = 0.0;
+        metrics_.log_likelihood = 0.0;
+
+        std::vector<Real> mean(sums_.size(), 0.0);
+        for (std::size_t i = 0; i < sums_.size() && count_ > 0; ++i) {
+            mean[i] = sums_[i] / static_cast<Real>(count_);
+        }
+        params_.resize(mean.size() * sizeof(Real));
+        if (!mean.empty()) {
+            std::memcpy(params_.data(), mean.data(), params_.size());
+        }
+    }
+
+    json              cfg_;
+    std::uint64_t     count_ = 0;
+    std::vector<Real> sums_;
+    ParameterBlob     params_;
+    TrainingMetrics   metrics_;
 };
 
 } // namespace KronosXPredict
@@ -97,6 +184,20 @@ KronosXPredict_destroy_realtime_model(KronosXPredict::IRealtimeModel* ptr) {
     delete ptr;
 }
 
+extern "C" KronosXPredict::IRealtimeModel*
+KronosXPredict_create_realtime_model_pmr(const nlohmann::json& config,
+                                         std::pmr::memory_resource* mr) {
+    std::pmr::polymorphic_allocator<> alloc(mr);
+    return alloc.new_object<KronosXPredict::StubRealtimeModel>(config, mr);
+}
+
+extern "C" void
+KronosXPredict_destroy_realtime_model_pmr(KronosXPredict::IRealtimeModel* ptr) {
+    auto* model = static_cast<KronosXPredict::StubRealtimeModel*>(ptr);
+    std::pmr::polymorphic_allocator<> alloc(model->resource());
+    alloc.delete_object(model);
+}
+
 extern "C" KronosXPredict::IModelTrainer*
 KronosXPredict_create_trainer(const nlohmann::json& config) {
     return new KronosXPredict::StubTrainer(config);
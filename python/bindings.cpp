@@ -8,12 +8,32 @@
 #include "KronosXPredict/api.hpp"
 #include "KronosXPredict/runtime.hpp"
 #include "KronosXPredict/plugin_loader.hpp"
+#include "KronosXPredict/alignment.hpp"
+#if defined(__linux__)
+  #include "KronosXPredict/ipc.hpp"
+#endif
 
 namespace py = pybind11;
 using json = nlohmann::json;
 
 namespace KronosXPredict {
 
+namespace {
+
+py::dict result_to_dict(const PredictionResult& r) {
+    py::dict out;
+    out["steps_ahead"] = r.steps_ahead;
+    out["target_kind"] = static_cast<int>(r.target_kind);
+    out["mean"]        = r.mean;
+    if (r.variance) {
+        out["variance"] = *r.variance;
+    }
+    out["scalars"] = r.scalars;
+    return out;
+}
+
+} // namespace
+
 class PyRealtimeWrapper {
 public:
     PyRealtimeWrapper(std::shared_ptr<PluginLibrary> lib,
@@ -51,17 +71,7 @@ public:
         req.steps_ahead      = steps_ahead;
         req.want_uncertainty = want_uncertainty;
 
-        PredictionResult r = model_->predict(req);
-
-        py::dict out;
-        out["steps_ahead"] = r.steps_ahead;
-        out["target_kind"] = static_cast<int>(r.target_kind);
-        out["mean"]        = r.mean;
-        if (r.variance) {
-            out["variance"] = *r.variance;
-        }
-        out["scalars"] = r.scalars;
-        return out;
+        return result_to_dict(model_->predict(req));
     }
 
 private:
@@ -69,6 +79,50 @@ private:
     std::unique_ptr<IRealtimeModel, RealtimeDestroyFn> model_;
 };
 
+#if defined(__linux__)
+class PyIpcClient {
+public:
+    PyIpcClient(const std::string& socket_path, const std::string& model)
+        : client_(socket_path, model) {}
+
+    void ingest(py::array_t<Real, py::array::c_style | py::array::forcecast> endogenous,
+                py::array_t<Real, py::array::c_style | py::array::forcecast> exogenous,
+                std::chrono::steady_clock::time_point t) {
+        // Values are copied straight from the numpy buffers into shared memory.
+        Observation obs{
+            t,
+            std::span<const Real>(endogenous.data(), static_cast<std::size_t>(endogenous.size())),
+            std::span<const Real>(exogenous.data(), static_cast<std::size_t>(exogenous.size()))
+        };
+        // May wait for ring space; the arrays stay alive as arguments.
+        py::gil_scoped_release release;
+        client_.ingest(obs);
+    }
+
+    bool ready() {
+        py::gil_scoped_release release;
+        return client_.ready();
+    }
+
+    py::dict predict(TargetKind kind, int steps_ahead, bool want_uncertainty) {
+        PredictionRequest req;
+        req.target_kind      = kind;
+        req.steps_ahead      = steps_ahead;
+        req.want_uncertainty = want_uncertainty;
+        PredictionResult r;
+        {
+            // Waiting on the response ring must not stall other Python threads.
+            py::gil_scoped_release release;
+            r = client_.predict(req);
+        }
+        return result_to_dict(r);
+    }
+
+private:
+    IpcClient client_;
+};
+#endif
+
 } // namespace KronosXPredict
 
 PYBIND11_MODULE(kronospredict, m) {
@@ -93,6 +147,24 @@ PYBIND11_MODULE(kronospredict, m) {
              py::arg("steps_ahead") = 1,
              py::arg("want_uncertainty") = true);
 
+#if defined(__linux__)
+    py::register_exception<IpcError>(m, "IpcError", PyExc_RuntimeError);
+
+    py::class_<PyIpcClient>(m, "IpcClient")
+        .def(py::init<const std::string&, const std::string&>(),
+             py::arg("socket_path"),
+             py::arg("model"))
+        .def("ingest", &PyIpcClient::ingest,
+             py::arg("endogenous"),
+             py::arg("exogenous"),
+             py::arg("t"))
+        .def_property_readonly("ready", &PyIpcClient::ready)
+        .def("predict", &PyIpcClient::predict,
+             py::arg("target_kind"),
+             py::arg("steps_ahead") = 1,
+             py::arg("want_uncertainty") = true);
+#endif
+
     m.def(
         "load_model",
         [](const std::string& plugin_path, const py::dict& config_dict) {
@@ -111,6 +183,62 @@ PYBIND11_MODULE(kronospredict, m) {
         py::arg("plugin_path"),
         py::arg("config"));
 
+    py::enum_<AlignTrigger>(m, "AlignTrigger")
+        .value("AnyUpdate", AlignTrigger::AnyUpdate)
+        .value("Stream", AlignTrigger::Stream)
+        .value("Grid", AlignTrigger::Grid);
+
+    m.def(
+        "align_csv",
+        [](const std::vector<std::string>& paths,
+           const std::vector<std::tuple<std::size_t, bool, std::size_t>>& layouts,
+           AlignTrigger trigger, std::size_t trigger_stream, std::int64_t grid_step_ns) {
+            // layouts[i] = (width, exogenous, offset) for the stream in paths[i]
+            std::vector<StreamLayout> streams;
+            for (const auto& [width, exo, offset] : layouts) {
+                streams.push_back(StreamLayout{
+                    width, exo ? ColumnBlock::Exogenous : ColumnBlock::Endogenous, offset});
+            }
+            AlignerConfig cfg;
+            cfg.trigger        = trigger;
+            cfg.trigger_stream = trigger_stream;
+            cfg.grid_step      = std::chrono::nanoseconds(grid_step_ns);
+            AsOfAligner aligner(std::move(streams), cfg);
+
+            std::vector<std::unique_ptr<CsvEventSource>> owned;
+            std::vector<IEventSource*> sources;
+            for (const auto& p : paths) {
+                owned.push_back(std::make_unique<CsvEventSource>(p));
+                sources.push_back(owned.back().get());
+            }
+
+            std::vector<std::int64_t> times;
+            std::vector<Real> endo;
+            std::vector<Real> exo;
+            {
+                py::gil_scoped_release release;
+                aligner.replay(sources, [&](const Observation& obs) {
+                    times.push_back(obs.t.time_since_epoch().count());
+                    endo.insert(endo.end(), obs.endogenous.begin(), obs.endogenous.end());
+                    exo.insert(exo.end(), obs.exogenous.begin(), obs.exogenous.end());
+                });
+            }
+
+            const auto rows = static_cast<py::ssize_t>(times.size());
+            const auto ne   = static_cast<py::ssize_t>(aligner.dim_endogenous());
+            const auto nx   = static_cast<py::ssize_t>(aligner.dim_exogenous());
+            py::dict out;
+            out["t"]          = py::array_t<std::int64_t>(rows, times.data());
+            out["endogenous"] = py::array_t<Real>({rows, ne}, endo.data());
+            out["exogenous"]  = py::array_t<Real>({rows, nx}, exo.data());
+            return out;
+        },
+        py::arg("paths"),
+        py::arg("layouts"),
+        py::arg("trigger") = AlignTrigger::AnyUpdate,
+        py::arg("trigger_stream") = 0,
+        py::arg("grid_step_ns") = 0);
+
     m.def("torch_demo", []() {
         auto r = KronosXPredict::torch_demo();
         return py::array_t<KronosXPredict::Real>(
@@ -0,0 +1,188 @@
+#include "KronosXPredict/alignment.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace KronosXPredict {
+
+// ---------------------------------------------------------------------------
+// CsvEventSource
+
+namespace {
+
+// True if only whitespace is left on the line.
+bool at_line_end(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+    return *p == '\0';
+}
+
+} // namespace
+
+CsvEventSource::CsvEventSource(const std::string& path)
+    : path_(path), in_(path) {
+    if (!in_) {
+        throw AlignmentError("Failed to open event file: " + path);
+    }
+}
+
+bool CsvEventSource::next(StreamEvent& out) {
+    while (std::getline(in_, line_)) {
+        ++line_no_;
+
+        if (line_.empty() || line_[0] == '#' || at_line_end(line_.c_str())) continue;
+
+        const char* p = line_.c_str();
+        char* end = nullptr;
+        errno = 0;
+        long long t = std::strtoll(p, &end, 10);
+        if (end == p || errno || (*end != ',' && !at_line_end(end))) {
+            throw AlignmentError(path_ + ":" + std::to_string(line_no_) + ": bad timestamp");
+        }
+
+        values_.clear();
+        p = end;
+        while (*p == ',') {
+            ++p;
+            Real v = std::strtod(p, &end);
+            if (end == p || (*end != ',' && !at_line_end(end))) {
+                throw AlignmentError(path_ + ":" + std::to_string(line_no_) + ": bad value");
+            }
+            values_.push_back(v);
+            p = end;
+        }
+
+        if (width_ == 0) {
+            width_ = values_.size();
+        } else if (values_.size() != width_) {
+            throw AlignmentError(path_ + ":" + std::to_string(line_no_) +
+                                 ": expected " + std::to_string(width_) + " values");
+        }
+
+        out.t      = TimePoint(Clock::duration(t));
+        out.values = values_;
+        return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// AsOfAligner
+
+AsOfAligner::AsOfAligner(std::vector<StreamLayout> streams, AlignerConfig cfg)
+    : streams_(std::move(streams)), cfg_(cfg),
+      seen_(streams_.size(), false), missing_(streams_.size()) {
+    if (streams_.empty()) {
+        throw AlignmentError("AsOfAligner needs at least one stream");
+    }
+    if (cfg_.trigger == AlignTrigger::Stream && cfg_.trigger_stream >= streams_.size()) {
+        throw AlignmentError("Trigger stream out of range");
+    }
+    if (cfg_.trigger == AlignTrigger::Grid && cfg_.grid_step <= Clock::duration::zero()) {
+        throw AlignmentError("Grid trigger needs a positive grid_step");
+    }
+
+    std::size_t n_endo = 0;
+    std::size_t n_exo  = 0;
+    for (const auto& s : streams_) {
+        auto& n = (s.block == ColumnBlock::Endogenous) ? n_endo : n_exo;
+        n = std::max(n, s.offset + s.width);
+    }
+    endogenous_.assign(n_endo, 0.0);
+    exogenous_.assign(n_exo, 0.0);
+}
+
+void AsOfAligner::emit(TimePoint t, const Sink& sink) {
+    if (cfg_.require_all && missing_ > 0) return;
+    Observation obs{
+        t,
+        std::span<const Real>(endogenous_.data(), endogenous_.size()),
+        std::span<const Real>(exogenous_.data(), exogenous_.size())
+    };
+    sink(obs);
+}
+
+void AsOfAligner::emit_grid_before(TimePoint t, const Sink& sink, bool inclusive) {
+    while (inclusive ? next_grid_ <= t : next_grid_ < t) {
+        emit(next_grid_, sink);
+        next_grid_ += cfg_.grid_step;
+    }
+}
+
+void AsOfAligner::on_event(std::size_t stream, TimePoint t, std::span<const Real> values,
+                           const Sink& sink) {
+    if (stream >= streams_.size()) {
+        throw AlignmentError("Stream index out of range");
+    }
+    const StreamLayout& s = streams_[stream];
+    if (values.size() != s.width) {
+        throw AlignmentError("Event width does not match stream layout");
+    }
+
+    if (!started_) {
+        started_ = true;
+        if (cfg_.trigger == AlignTrigger::Grid) {
+            // First grid point at or after the first event.
+            auto k = (t - cfg_.grid_origin) / cfg_.grid_step;
+            next_grid_ = cfg_.grid_origin + k * cfg_.grid_step;
+            if (next_grid_ < t) next_grid_ += cfg_.grid_step;
+        }
+    } else if (t < last_t_) {
+        throw AlignmentError("Events must arrive in timestamp order");
+    }
+    last_t_ = t;
+
+    // Grid points strictly before t see the state prior to this event.
+    if (cfg_.trigger == AlignTrigger::Grid) {
+        emit_grid_before(t, sink, false);
+    }
+
+    Real* dst = (s.block == ColumnBlock::Endogenous ? endogenous_.data() : exogenous_.data()) + s.offset;
+    std::copy(values.begin(), values.end(), dst);
+    if (!seen_[stream]) {
+        seen_[stream] = true;
+        --missing_;
+    }
+
+    if (cfg_.trigger == AlignTrigger::AnyUpdate ||
+        (cfg_.trigger == AlignTrigger::Stream && stream == cfg_.trigger_stream)) {
+        emit(t, sink);
+    }
+}
+
+void AsOfAligner::advance_to(TimePoint now, const Sink& sink) {
+    if (cfg_.trigger != AlignTrigger::Grid || !started_ || now < last_t_) return;
+    emit_grid_before(now, sink, true);
+}
+
+std::size_t AsOfAligner::replay(std::span<IEventSource* const> sources, const Sink& sink) {
+    if (sources.size() != streams_.size()) {
+        throw AlignmentError("replay needs exactly one source per stream");
+    }
+
+    using Head = std::pair<TimePoint, std::size_t>;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+    std::vector<StreamEvent> heads(sources.size());
+
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i]->next(heads[i])) heap.emplace(heads[i].t, i);
+    }
+
+    std::size_t n = 0;
+    while (!heap.empty()) {
+        const std::size_t i = heap.top().second;
+        heap.pop();
+        on_event(i, heads[i].t, heads[i].values, sink);
+        ++n;
+        if (sources[i]->next(heads[i])) heap.emplace(heads[i].t, i);
+    }
+
+    // on_event only flushes grid points strictly before each event.
+    advance_to(last_t_, sink);
+    return n;
+}
+
+} // namespace KronosXPredict
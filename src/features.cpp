@@ -0,0 +1,389 @@
+#include "KronosXPredict/features.hpp"
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace KronosXPredict {
+
+namespace {
+
+bool is_windowed(FeatureOp op) {
+    return op == FeatureOp::ZScore || op == FeatureOp::RollingVol;
+}
+
+FeatureOp parse_op(const std::string& name) {
+    if (name == "log_return")  return FeatureOp::LogReturn;
+    if (name == "diff")        return FeatureOp::Diff;
+    if (name == "zscore")      return FeatureOp::ZScore;
+    if (name == "rolling_vol") return FeatureOp::RollingVol;
+    if (name == "lag")         return FeatureOp::Lag;
+    throw FeatureError("Unknown feature op: " + name);
+}
+
+void require_instrument(const json& spec) {
+    if (!spec.is_object()) {
+        throw FeatureError("features must be an object");
+    }
+    auto it = spec.find("instrument");
+    if (it == spec.end() || !it->is_string() || it->get<std::string>().empty()) {
+        throw FeatureError("features.instrument is required");
+    }
+}
+
+std::vector<FeatureStageSpec> parse_stages(const json& spec, const char* block) {
+    std::vector<FeatureStageSpec> out;
+    auto it = spec.find(block);
+    if (it == spec.end()) return out;
+    if (!it->is_array()) {
+        throw FeatureError(std::string("features.") + block + " must be an array");
+    }
+    for (const auto& st : *it) {
+        FeatureStageSpec s;
+        s.op = parse_op(st.at("op").get<std::string>());
+        if (is_windowed(s.op) && !st.contains("window")) {
+            throw FeatureError("Feature op " + st.at("op").get<std::string>() +
+                               " requires a window");
+        }
+        s.window = st.value("window", std::size_t{1});
+        out.push_back(s);
+    }
+    return out;
+}
+
+class FeaturedRealtimeModel : public IRealtimeModel, public IFeatureSubscriber {
+public:
+    FeaturedRealtimeModel(std::unique_ptr<IRealtimeModel, RealtimeDestroyFn> inner,
+                          std::shared_ptr<FeaturePipeline> pipeline)
+        : inner_(std::move(inner)), pipeline_(std::move(pipeline)) {
+        pipeline_->subscribe(this);
+    }
+
+    ~FeaturedRealtimeModel() override {
+        pipeline_->unsubscribe(this);
+    }
+
+    void on_features(const Observation& row) override {
+        std::lock_guard<std::mutex> lk(mutex_);
+        inner_->ingest(row);
+    }
+
+    void ingest(const Observation&) override {
+        throw FeatureError("Featured models are fed by FeaturePipeline::push, not ingest()");
+    }
+
+    bool ready() const noexcept override {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return inner_->ready();
+    }
+
+    PredictionResult predict(const PredictionRequest& req) const override {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return inner_->predict(req);
+    }
+
+    void reset() override {
+        std::lock_guard<std::mutex> lk(mutex_);
+        inner_->reset();
+    }
+
+    ModelKind kind() const noexcept override {
+        return inner_->kind();
+    }
+
+private:
+    mutable std::mutex                                 mutex_; // guards inner_
+    std::unique_ptr<IRealtimeModel, RealtimeDestroyFn> inner_;
+    std::shared_ptr<FeaturePipeline>                   pipeline_;
+};
+
+void destroy_featured_model(IRealtimeModel* ptr) {
+    delete ptr;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FeatureChain
+
+FeatureChain::FeatureChain(std::vector<FeatureStageSpec> stages) {
+    for (const auto& spec : stages) {
+        if (spec.window == 0 || (is_windowed(spec.op) && spec.window < 2)) {
+            throw FeatureError("Feature window too small");
+        }
+        Stage s;
+        s.spec = spec;
+        stages_.push_back(std::move(s));
+    }
+
+    for (std::size_t i = 0; i < stages_.size();) {
+        if (stages_[i].spec.op == FeatureOp::Lag) {
+            segments_.push_back(Segment{i, i + 1, false, {}});
+            ++i;
+            continue;
+        }
+        std::size_t j = i;
+        while (j < stages_.size() && stages_[j].spec.op != FeatureOp::Lag) ++j;
+        segments_.push_back(Segment{i, j, true, {}});
+        i = j;
+    }
+}
+
+void FeatureChain::allocate(std::size_t width) {
+    width_ = width;
+    passthrough_.resize(width);
+
+    std::size_t w = width;
+    for (auto& s : stages_) {
+        s.in_width = w;
+        switch (s.spec.op) {
+        case FeatureOp::LogReturn:
+        case FeatureOp::Diff:
+            s.warmup = 1;
+            s.prev.assign(w, 0.0);
+            s.out_width = w;
+            break;
+        case FeatureOp::ZScore:
+        case FeatureOp::RollingVol:
+            s.warmup = s.spec.window - 1;
+            s.ring.assign(s.spec.window * w, 0.0);
+            s.sum.assign(w, 0.0);
+            s.sumsq.assign(w, 0.0);
+            s.out_width = w;
+            break;
+        case FeatureOp::Lag:
+            s.warmup = s.spec.window;
+            s.ring.assign(s.spec.window * w, 0.0);
+            s.out_width = w * (s.spec.window + 1);
+            break;
+        }
+        w = s.out_width;
+    }
+
+    for (auto& seg : segments_) {
+        seg.out.assign(stages_[seg.last - 1].out_width, 0.0);
+    }
+    allocated_ = true;
+}
+
+Real FeatureChain::step(Stage& s, std::size_t j, Real v) {
+    switch (s.spec.op) {
+    case FeatureOp::LogReturn: {
+        Real r = s.seen ? std::log(v / s.prev[j]) : 0.0;
+        s.prev[j] = v;
+        return r;
+    }
+    case FeatureOp::Diff: {
+        Real r = s.seen ? v - s.prev[j] : 0.0;
+        s.prev[j] = v;
+        return r;
+    }
+    case FeatureOp::ZScore:
+    case FeatureOp::RollingVol: {
+        const std::size_t W = s.spec.window;
+        Real& slot = s.ring[s.pos * s.in_width + j];
+        if (s.seen >= W) {
+            s.sum[j]   -= slot;
+            s.sumsq[j] -= slot * slot;
+        }
+        slot = v;
+        s.sum[j]   += v;
+        s.sumsq[j] += v * v;
+
+        const Real n    = static_cast<Real>(std::min(s.seen + 1, W));
+        const Real mean = s.sum[j] / n;
+        const Real var  = n > 1 ? std::max(0.0, (s.sumsq[j] - n * mean * mean) / (n - 1)) : 0.0;
+        const Real sd   = std::sqrt(var);
+        if (s.spec.op == FeatureOp::RollingVol) return sd;
+        return sd > 0 ? (v - mean) / sd : 0.0;
+    }
+    case FeatureOp::Lag:
+        break;
+    }
+    return v;
+}
+
+void FeatureChain::advance(Stage& s) {
+    ++s.seen;
+    if (s.ring.empty()) return;
+    s.pos = (s.pos + 1) % s.spec.window;
+
+    // Re-derive the running sums once per window so rounding cannot accumulate.
+    if (s.pos == 0 && is_windowed(s.spec.op)) {
+        std::fill(s.sum.begin(), s.sum.end(), 0.0);
+        std::fill(s.sumsq.begin(), s.sumsq.end(), 0.0);
+        for (std::size_t k = 0; k < s.spec.window; ++k) {
+            const Real* row = &s.ring[k * s.in_width];
+            for (std::size_t j = 0; j < s.in_width; ++j) {
+                s.sum[j]   += row[j];
+                s.sumsq[j] += row[j] * row[j];
+            }
+        }
+    }
+}
+
+std::span<const Real> FeatureChain::push(std::span<const Real> in) {
+    if (!allocated_) {
+        allocate(in.size());
+    } else if (in.size() != width_) {
+        throw FeatureError("Feature input width changed");
+    }
+
+    if (stages_.empty()) {
+        std::copy(in.begin(), in.end(), passthrough_.begin());
+        ready_ = true;
+        return passthrough_;
+    }
+
+    // A stage only consumes rows its predecessors consider valid.
+    std::size_t reach = 0;
+    bool valid = true;
+    for (const auto& s : stages_) {
+        ++reach;
+        if (s.seen < s.warmup) {
+            valid = false;
+            break;
+        }
+    }
+
+    std::span<const Real> cur = in;
+    for (auto& seg : segments_) {
+        if (seg.first >= reach) break;
+
+        if (seg.fused) {
+            const std::size_t end = std::min(seg.last, reach);
+            for (std::size_t j = 0; j < cur.size(); ++j) {
+                Real v = cur[j];
+                for (std::size_t k = seg.first; k < end; ++k) {
+                    v = step(stages_[k], j, v);
+                }
+                seg.out[j] = v;
+            }
+            for (std::size_t k = seg.first; k < end; ++k) {
+                advance(stages_[k]);
+            }
+        } else {
+            Stage& s = stages_[seg.first];
+            const std::size_t k = s.spec.window;
+            const std::size_t w = s.in_width;
+            for (std::size_t j = 0; j < w; ++j) {
+                Real* out = &seg.out[j * (k + 1)];
+                out[0] = cur[j];
+                for (std::size_t l = 1; l <= k; ++l) {
+                    out[l] = s.ring[((s.pos + k - l) % k) * w + j];
+                }
+                s.ring[s.pos * w + j] = cur[j];
+            }
+            advance(s);
+        }
+        cur = seg.out;
+    }
+
+    ready_ = valid;
+    return valid ? cur : std::span<const Real>();
+}
+
+void FeatureChain::reset() {
+    for (auto& s : stages_) {
+        s.seen = 0;
+        s.pos  = 0;
+        std::fill(s.prev.begin(), s.prev.end(), 0.0);
+        std::fill(s.ring.begin(), s.ring.end(), 0.0);
+        std::fill(s.sum.begin(), s.sum.end(), 0.0);
+        std::fill(s.sumsq.begin(), s.sumsq.end(), 0.0);
+    }
+    ready_ = false;
+}
+
+// ---------------------------------------------------------------------------
+// FeaturePipeline
+
+FeaturePipeline::FeaturePipeline(std::vector<FeatureStageSpec> endogenous,
+                                 std::vector<FeatureStageSpec> exogenous)
+    : endogenous_(std::move(endogenous)), exogenous_(std::move(exogenous)) {}
+
+std::shared_ptr<FeaturePipeline> FeaturePipeline::from_json(const json& spec) {
+    require_instrument(spec);
+    return std::make_shared<FeaturePipeline>(parse_stages(spec, "endogenous"),
+                                             parse_stages(spec, "exogenous"));
+}
+
+bool FeaturePipeline::push(std::uint64_t seq, const Observation& obs) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (have_seq_ && seq <= last_seq_) {
+        return false;
+    }
+    last_seq_ = seq;
+    have_seq_ = true;
+
+    Observation row{obs.t, endogenous_.push(obs.endogenous), exogenous_.push(obs.exogenous)};
+    computed_.fetch_add(1, std::memory_order_relaxed);
+
+    const bool valid = endogenous_.ready() && exogenous_.ready();
+    ready_.store(valid, std::memory_order_release);
+    if (valid) {
+        for (IFeatureSubscriber* sub : subscribers_) {
+            sub->on_features(row);
+        }
+    }
+    return true;
+}
+
+void FeaturePipeline::subscribe(IFeatureSubscriber* sub) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    subscribers_.push_back(sub);
+}
+
+void FeaturePipeline::unsubscribe(IFeatureSubscriber* sub) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    subscribers_.erase(std::remove(subscribers_.begin(), subscribers_.end(), sub),
+                       subscribers_.end());
+}
+
+void FeaturePipeline::reset() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    endogenous_.reset();
+    exogenous_.reset();
+    have_seq_ = false;
+    ready_.store(false, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// FeaturePipelineRegistry
+
+std::shared_ptr<FeaturePipeline> FeaturePipelineRegistry::acquire(const json& spec) {
+    // Without an instrument, two feeds with equal transforms would share state.
+    require_instrument(spec);
+    const std::string key = spec.dump();
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (auto existing = pipelines_[key].lock()) {
+        return existing;
+    }
+    auto p = FeaturePipeline::from_json(spec);
+    pipelines_[key] = p;
+    return p;
+}
+
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
+make_featured_model(std::unique_ptr<IRealtimeModel, RealtimeDestroyFn> inner,
+                    std::shared_ptr<FeaturePipeline> pipeline) {
+    return std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>(
+        new FeaturedRealtimeModel(std::move(inner), std::move(pipeline)),
+        destroy_featured_model);
+}
+
+std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
+create_realtime_with_features(const PluginLibrary& lib, const json& cfg,
+                              FeaturePipelineRegistry& registry) {
+    auto model = lib.create_realtime(cfg);
+    auto it = cfg.find("features");
+    if (it == cfg.end()) {
+        return model;
+    }
+    return make_featured_model(std::move(model), registry.acquire(*it));
+}
+
+} // namespace KronosXPredict
@@ -0,0 +1,534 @@
+#include "KronosXPredict/ipc.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+#endif
+
+namespace KronosXPredict {
+
+namespace {
+
+void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Polls a client spins on the response ring before yielding its core. On a
+// single CPU the server only runs once the client yields.
+const std::size_t kClientSpinBeforeYield =
+    std::thread::hardware_concurrency() > 1 ? 4096 : 0;
+
+std::string errno_message(const std::string& what) {
+    return what + ": " + std::strerror(errno);
+}
+
+sockaddr_un make_address(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw IpcError("Socket path too long: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+void send_line(int fd, const std::string& line) {
+    std::string buf = line + "\n";
+    const char* p = buf.data();
+    std::size_t left = buf.size();
+    while (left > 0) {
+        ssize_t n = ::send(fd, p, left, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw IpcError(errno_message("Control socket send failed"));
+        }
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
+
+std::string read_line(int fd, std::chrono::milliseconds timeout) {
+    std::string line;
+    const auto deadline = Clock::now() + timeout;
+    for (;;) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+        if (left.count() <= 0) {
+            throw IpcError("Timed out on control socket");
+        }
+        pollfd p{fd, POLLIN, 0};
+        int rc = ::poll(&p, 1, static_cast<int>(left.count()));
+        if (rc < 0) {
+            if (errno == EINTR) continue;
+            throw IpcError(errno_message("Control socket poll failed"));
+        }
+        if (rc == 0) continue;
+
+        char c;
+        ssize_t n = ::recv(fd, &c, 1, 0);
+        if (n == 0) throw IpcError("Control socket closed by peer");
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw IpcError(errno_message("Control socket recv failed"));
+        }
+        if (c == '\n') return line;
+        line.push_back(c);
+        if (line.size() > 1024) throw IpcError("Control message too long");
+    }
+}
+
+IpcSegment* map_segment(int shm_fd) {
+    void* addr = ::mmap(nullptr, sizeof(IpcSegment), PROT_READ | PROT_WRITE,
+                        MAP_SHARED, shm_fd, 0);
+    if (addr == MAP_FAILED) {
+        throw IpcError(errno_message("mmap of IPC segment failed"));
+    }
+    return static_cast<IpcSegment*>(addr);
+}
+
+void unmap_segment(IpcSegment* seg) {
+    if (seg) ::munmap(seg, sizeof(IpcSegment));
+}
+
+void copy_error(IpcResponse& out, const char* what) {
+    out.status = IpcStatus::Error;
+    std::strncpy(out.error, what, sizeof(out.error) - 1);
+    out.error[sizeof(out.error) - 1] = '\0';
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// IpcClient
+
+IpcClient::IpcClient(const std::string& socket_path, const std::string& model,
+                     std::chrono::milliseconds timeout)
+    : timeout_(timeout) {
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        throw IpcError(errno_message("socket() failed"));
+    }
+    try {
+        sockaddr_un addr = make_address(socket_path);
+        if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            throw IpcError(errno_message("Failed to connect to " + socket_path));
+        }
+
+        send_line(fd_, "OPEN " + model);
+        std::string reply = read_line(fd_, timeout_);
+        if (reply.rfind("OK ", 0) != 0) {
+            throw IpcError("Server refused session: " + reply);
+        }
+        std::string shm_name = reply.substr(3);
+
+        int shm_fd = ::shm_open(shm_name.c_str(), O_RDWR, 0);
+        if (shm_fd < 0) {
+            throw IpcError(errno_message("shm_open(" + shm_name + ") failed"));
+        }
+        try {
+            seg_ = map_segment(shm_fd);
+        } catch (...) {
+            ::close(shm_fd);
+            throw;
+        }
+        ::close(shm_fd);
+
+        if (seg_->magic.load(std::memory_order_acquire) != IPC_MAGIC ||
+            seg_->version != IPC_VERSION) {
+            throw IpcError("IPC segment has an incompatible layout");
+        }
+        send_line(fd_, "MAPPED");
+    } catch (...) {
+        unmap_segment(seg_);
+        ::close(fd_);
+        throw;
+    }
+}
+
+IpcClient::~IpcClient() {
+    unmap_segment(seg_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+IpcRequest& IpcClient::next_request() {
+    std::size_t spins = 0;
+    for (;;) {
+        if (IpcRequest* slot = seg_->requests.begin_push()) {
+            slot->seq = ++seq_;
+            return *slot;
+        }
+        if (seg_->closed.load(std::memory_order_acquire)) {
+            throw IpcError("IPC session closed by server");
+        }
+        if (++spins % 1024 == 0) std::this_thread::yield();
+        else cpu_relax();
+    }
+}
+
+const IpcResponse& IpcClient::await_response(std::uint64_t seq) {
+    const auto deadline = Clock::now() + timeout_;
+    std::size_t spins = 0;
+    for (;;) {
+        if (const IpcResponse* r = seg_->responses.front()) {
+            if (r->seq == seq) return *r;
+            seg_->responses.pop(); // left over from a timed-out call
+            continue;
+        }
+        if (++spins % 1024 == 0) {
+            if (seg_->closed.load(std::memory_order_acquire)) {
+                throw IpcError("IPC session closed by server");
+            }
+            if (Clock::now() > deadline) {
+                throw IpcError("Timed out waiting for IPC response");
+            }
+        }
+        if (spins < kClientSpinBeforeYield) cpu_relax();
+        else std::this_thread::yield();
+    }
+}
+
+void IpcClient::ingest(const Observation& obs) {
+    const std::size_t ne = obs.endogenous.size();
+    const std::size_t nx = obs.exogenous.size();
+    if (ne + nx > IPC_MAX_VALUES) {
+        throw IpcError("Observation exceeds IPC_MAX_VALUES");
+    }
+
+    IpcRequest& req = next_request();
+    req.kind         = IpcMessageKind::Ingest;
+    req.t            = obs.t.time_since_epoch().count();
+    req.n_endogenous = static_cast<std::uint32_t>(ne);
+    req.n_exogenous  = static_cast<std::uint32_t>(nx);
+    std::copy(obs.endogenous.begin(), obs.endogenous.end(), req.values);
+    std::copy(obs.exogenous.begin(), obs.exogenous.end(), req.values + ne);
+    seg_->requests.commit_push();
+}
+
+bool IpcClient::ready() {
+    IpcRequest& req = next_request();
+    req.kind = IpcMessageKind::Ready;
+    const std::uint64_t seq = req.seq;
+    seg_->requests.commit_push();
+
+    const IpcResponse& r = await_response(seq);
+    if (r.status != IpcStatus::Ok) {
+        std::string msg(r.error);
+        seg_->responses.pop();
+        throw IpcError(msg);
+    }
+    bool ready = r.ready != 0;
+    seg_->responses.pop();
+    return ready;
+}
+
+PredictionResult IpcClient::predict(const PredictionRequest& pr) {
+    IpcRequest& req = next_request();
+    req.kind             = IpcMessageKind::Predict;
+    req.target_kind      = static_cast<std::int32_t>(pr.target_kind);
+    req.steps_ahead      = pr.steps_ahead;
+    req.want_uncertainty = pr.want_uncertainty ? 1u : 0u;
+    const std::uint64_t seq = req.seq;
+    seg_->requests.commit_push();
+
+    const IpcResponse& r = await_response(seq);
+    if (r.status != IpcStatus::Ok) {
+        std::string msg(r.error);
+        seg_->responses.pop();
+        throw IpcError(msg);
+    }
+
+    PredictionResult out(pr.result_resource);
+    out.based_on    = TimePoint(Clock::duration(r.based_on));
+    out.target_kind = static_cast<TargetKind>(r.target_kind);
+    out.steps_ahead = r.steps_ahead;
+    out.mean.assign(r.mean, r.mean + r.n);
+    if (r.has_variance) {
+        std::copy(r.variance, r.variance + r.n, out.emplace_variance(r.n).begin());
+    }
+    for (std::uint32_t i = 0; i < r.n_scalars; ++i) {
+        out.scalars.emplace(r.scalars[i].key, r.scalars[i].value);
+    }
+    seg_->responses.pop();
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// IpcServer
+
+IpcServer::IpcServer(std::string socket_path, IpcServerOptions opts)
+    : socket_path_(std::move(socket_path)), opts_(opts) {}
+
+IpcServer::~IpcServer() {
+    stop();
+}
+
+void IpcServer::add_model(const std::string& name,
+                          std::shared_ptr<RealtimeModelInstance> instance) {
+    if (acceptor_.joinable()) {
+        throw IpcError("Models must be added before IpcServer::start()");
+    }
+    auto hosted = std::make_unique<HostedModel>();
+    hosted->instance = std::move(instance);
+    models_[name] = std::move(hosted);
+}
+
+void IpcServer::start() {
+    if (acceptor_.joinable()) return;
+
+    sockaddr_un addr = make_address(socket_path_);
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        throw IpcError(errno_message("socket() failed"));
+    }
+    ::unlink(socket_path_.c_str());
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd_, 64) < 0) {
+        std::string msg = errno_message("Failed to listen on " + socket_path_);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        throw IpcError(msg);
+    }
+
+    stopping_ = false;
+    acceptor_ = std::thread([this] { accept_loop(); });
+}
+
+void IpcServer::stop() {
+    if (!acceptor_.joinable()) return;
+    stopping_ = true;
+    acceptor_.join();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    ::unlink(socket_path_.c_str());
+}
+
+void IpcServer::accept_loop() {
+    while (!stopping_) {
+        pollfd p{listen_fd_, POLLIN, 0};
+        int rc = ::poll(&p, 1, 100);
+        reap(false);
+        if (rc <= 0) continue;
+
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) continue;
+        // The handshake runs on the session's own thread, so a slow or silent
+        // client cannot hold up other connections.
+        Session& s = sessions_.emplace_back();
+        s.fd = fd;
+        s.shm_name = "/kxp." + std::to_string(::getpid()) + "." +
+                     std::to_string(next_session_++);
+        s.worker = std::thread([this, &s] { run_session(s); });
+    }
+    reap(true);
+}
+
+void IpcServer::run_session(Session& s) {
+    try {
+        open_session(s);
+    } catch (const std::exception& e) {
+        try { send_line(s.fd, std::string("ERR ") + e.what()); } catch (...) {}
+        s.done = true;
+        return;
+    }
+    serve(s);
+}
+
+void IpcServer::open_session(Session& s) {
+    std::string line = read_line(s.fd, std::chrono::milliseconds(1000));
+    if (line.rfind("OPEN ", 0) != 0) {
+        throw IpcError("Expected OPEN <model>");
+    }
+    auto it = models_.find(line.substr(5));
+    if (it == models_.end()) {
+        throw IpcError("Unknown model: " + line.substr(5));
+    }
+
+    const std::string& name = s.shm_name;
+    int shm_fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (shm_fd < 0) {
+        throw IpcError(errno_message("shm_open(" + name + ") failed"));
+    }
+    try {
+        if (::ftruncate(shm_fd, sizeof(IpcSegment)) < 0) {
+            throw IpcError(errno_message("ftruncate of IPC segment failed"));
+        }
+        s.seg = map_segment(shm_fd);
+    } catch (...) {
+        ::close(shm_fd);
+        ::shm_unlink(name.c_str());
+        s.unlinked = true;
+        throw;
+    }
+    ::close(shm_fd);
+
+    new (s.seg) IpcSegment();
+    s.seg->magic.store(IPC_MAGIC, std::memory_order_release);
+    s.model = it->second.get();
+
+    send_line(s.fd, "OK " + name);
+    line = read_line(s.fd, std::chrono::milliseconds(1000));
+    // Both sides hold the mapping now; the name is no longer needed.
+    ::shm_unlink(name.c_str());
+    s.unlinked = true;
+    if (line != "MAPPED") {
+        throw IpcError("Expected MAPPED");
+    }
+}
+
+void IpcServer::reap(bool all) {
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+        if (!all && !it->done) {
+            ++it;
+            continue;
+        }
+        if (it->worker.joinable()) it->worker.join();
+        if (it->seg) {
+            it->seg->closed.store(1, std::memory_order_release);
+            unmap_segment(it->seg);
+        }
+        if (it->seg && !it->unlinked) ::shm_unlink(it->shm_name.c_str());
+        ::close(it->fd);
+        it = sessions_.erase(it);
+    }
+}
+
+void IpcServer::serve(Session& s) {
+    IpcSegment& seg = *s.seg;
+    std::size_t idle = 0;
+
+    while (!stopping_) {
+        if (const IpcRequest* req = seg.requests.front()) {
+            handle(s, *req);
+            seg.requests.pop();
+            idle = 0;
+            continue;
+        }
+
+        ++idle;
+        if (idle < opts_.spin_before_yield) {
+            cpu_relax();
+            continue;
+        }
+
+        // Idle: watch for the client hanging up on the control socket.
+        if (idle % 1024 == 0) {
+            pollfd p{s.fd, POLLIN, 0};
+            if (::poll(&p, 1, 0) > 0) {
+                char c;
+                if (::recv(s.fd, &c, 1, MSG_DONTWAIT) <= 0) break;
+            }
+        }
+        if (idle < opts_.spin_before_yield + opts_.yield_before_sleep) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    seg.closed.store(1, std::memory_order_release);
+    s.done = true;
+}
+
+void IpcServer::handle(Session& s, const IpcRequest& req) {
+    HostedModel& m = *s.model;
+
+    if (req.kind == IpcMessageKind::Ingest) {
+        // Ingest has no response; a failure is reported on the next reply.
+        try {
+            if (req.n_endogenous + req.n_exogenous > IPC_MAX_VALUES) {
+                throw IpcError("Observation exceeds IPC_MAX_VALUES");
+            }
+            Observation obs{
+                TimePoint(Clock::duration(req.t)),
+                std::span<const Real>(req.values, req.n_endogenous),
+                std::span<const Real>(req.values + req.n_endogenous, req.n_exogenous)
+            };
+            std::lock_guard<std::mutex> lk(m.mutex);
+            m.instance->model().ingest(obs);
+        } catch (const std::exception& e) {
+            if (s.pending_error.empty()) {
+                s.pending_error = std::string("ingest failed: ") + e.what();
+            }
+        }
+        return;
+    }
+
+    IpcSegment& seg = *s.seg;
+    IpcResponse* out = nullptr;
+    while (!(out = seg.responses.begin_push())) {
+        if (stopping_) return;
+        cpu_relax();
+    }
+    out->seq      = req.seq;
+    out->status   = IpcStatus::Ok;
+    out->ready     = 0;
+    out->n         = 0;
+    out->n_scalars = 0;
+    out->error[0]  = '\0';
+
+    try {
+        if (!s.pending_error.empty()) {
+            std::string msg = std::move(s.pending_error);
+            s.pending_error.clear();
+            throw IpcError(msg);
+        }
+
+        std::lock_guard<std::mutex> lk(m.mutex);
+        IRealtimeModel& model = m.instance->model();
+        out->ready = model.ready() ? 1u : 0u;
+
+        if (req.kind == IpcMessageKind::Predict) {
+            PredictionRequest pr;
+            pr.target_kind      = static_cast<TargetKind>(req.target_kind);
+            pr.steps_ahead      = req.steps_ahead;
+            pr.want_uncertainty = req.want_uncertainty != 0;
+            PredictionResult r = model.predict(pr);
+
+            if (r.mean.size() > IPC_MAX_VALUES) {
+                throw IpcError("Prediction exceeds IPC_MAX_VALUES");
+            }
+            if (r.variance && r.variance->size() != r.mean.size()) {
+                throw IpcError("Prediction variance size does not match mean");
+            }
+            if (r.scalars.size() > IPC_MAX_SCALARS) {
+                throw IpcError("Prediction exceeds IPC_MAX_SCALARS");
+            }
+            out->target_kind  = static_cast<std::int32_t>(r.target_kind);
+            out->steps_ahead  = r.steps_ahead;
+            out->based_on     = r.based_on.time_since_epoch().count();
+            out->n            = static_cast<std::uint32_t>(r.mean.size());
+            out->has_variance = r.variance ? 1u : 0u;
+            std::copy(r.mean.begin(), r.mean.end(), out->mean);
+            if (r.variance) {
+                std::copy(r.variance->begin(), r.variance->end(), out->variance);
+            }
+            for (const auto& [key, value] : r.scalars) {
+                if (key.size() >= IPC_SCALAR_KEY) {
+                    throw IpcError("Prediction scalar key too long: " + std::string(key));
+                }
+                IpcScalar& slot = out->scalars[out->n_scalars++];
+                std::memcpy(slot.key, key.c_str(), key.size() + 1);
+                slot.value = value;
+            }
+        }
+    } catch (const std::exception& e) {
+        copy_error(*out, e.what());
+    }
+    seg.responses.commit_push();
+}
+
+} // namespace KronosXPredict
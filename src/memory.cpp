@@ -0,0 +1,81 @@
+#include "KronosXPredict/memory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace KronosXPredict {
+
+namespace {
+
+constexpr std::size_t kPageSize = 4096;
+
+#if defined(__linux__)
+// Binds [addr, addr + len) to one NUMA node. Avoids a libnuma dependency; a
+// failure (no NUMA support, bad node) just leaves first-touch placement.
+void bind_to_node(void* addr, std::size_t len, int node) {
+    constexpr long kMpolBind = 2;
+    constexpr std::size_t kMaskBits = 1024;
+    unsigned long mask[kMaskBits / (8 * sizeof(unsigned long))] = {};
+    if (node < 0 || static_cast<std::size_t>(node) >= kMaskBits) return;
+    mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    ::syscall(SYS_mbind, addr, len, kMpolBind, mask, kMaskBits + 1, 0);
+}
+#endif
+
+void* map_region(std::size_t len) {
+#if defined(__linux__)
+    void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    return p;
+#else
+    return ::operator new(len, std::align_val_t(kPageSize));
+#endif
+}
+
+void unmap_region(void* p, std::size_t len) {
+    if (!p) return;
+#if defined(__linux__)
+    ::munmap(p, len);
+#else
+    (void)len;
+    ::operator delete(p, std::align_val_t(kPageSize));
+#endif
+}
+
+} // namespace
+
+ModelArena::ModelArena(ArenaOptions opts) {
+    region_size_ = (std::max(opts.initial_bytes, kPageSize) + kPageSize - 1) / kPageSize * kPageSize;
+    region_ = map_region(region_size_);
+
+#if defined(__linux__)
+    if (opts.numa_node >= 0) {
+        bind_to_node(region_, region_size_, opts.numa_node);
+    }
+#endif
+    // Fault every page in now so placement is decided here, not on the hot path.
+    std::memset(region_, 0, region_size_);
+
+    monotonic_ = std::make_unique<std::pmr::monotonic_buffer_resource>(region_, region_size_);
+    if (opts.synchronized) {
+        pool_ = std::make_unique<std::pmr::synchronized_pool_resource>(monotonic_.get());
+    } else {
+        pool_ = std::make_unique<std::pmr::unsynchronized_pool_resource>(monotonic_.get());
+    }
+}
+
+ModelArena::~ModelArena() {
+    pool_.reset();
+    monotonic_.reset();
+    unmap_region(region_, region_size_);
+}
+
+} // namespace KronosXPredict
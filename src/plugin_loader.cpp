@@ -1,6 +1,9 @@
 #include "KronosXPredict/plugin_loader.hpp"
+#include "KronosXPredict/plugin_registry.hpp"
 #include <nlohmann/json.hpp>
 
+#include <type_traits>
+
 #if defined(_WIN32)
   #include <windows.h>
 #else
@@ -36,19 +39,12 @@ void close_library(void* handle) {
 #endif
 }
 
-void* load_symbol(void* handle, const char* name) {
+// Returns nullptr when the symbol is absent; optional exports are probed with this.
+void* find_symbol(void* handle, const char* name) {
 #if defined(_WIN32)
-    FARPROC sym = GetProcAddress(reinterpret_cast<HMODULE>(handle), name);
-    if (!sym) {
-        throw PluginError(std::string("Failed to load symbol: ") + name);
-    }
-    return reinterpret_cast<void*>(sym);
+    return reinterpret_cast<void*>(GetProcAddress(reinterpret_cast<HMODULE>(handle), name));
 #else
-    void* sym = dlsym(handle, name);
-    if (!sym) {
-        throw PluginError(std::string("Failed to load symbol: ") + name + " (" + dlerror() + ")");
-    }
-    return sym;
+    return dlsym(handle, name);
 #endif
 }
 
@@ -67,11 +63,15 @@ PluginLibrary::PluginLibrary(PluginLibrary&& other) noexcept {
     handle_      = other.handle_;
     rt_factory_  = other.rt_factory_;
     rt_destroy_  = other.rt_destroy_;
+    rt_factory_pmr_ = other.rt_factory_pmr_;
+    rt_destroy_pmr_ = other.rt_destroy_pmr_;
     tr_factory_  = other.tr_factory_;
     tr_destroy_  = other.tr_destroy_;
     other.handle_ = nullptr;
     other.rt_factory_ = nullptr;
     other.rt_destroy_ = nullptr;
+    other.rt_factory_pmr_ = nullptr;
+    other.rt_destroy_pmr_ = nullptr;
     other.tr_factory_ = nullptr;
     other.tr_destroy_ = nullptr;
 }
@@ -82,11 +82,15 @@ PluginLibrary& PluginLibrary::operator=(PluginLibrary&& other) noexcept {
         handle_      = other.handle_;
         rt_factory_  = other.rt_factory_;
         rt_destroy_  = other.rt_destroy_;
+        rt_factory_pmr_ = other.rt_factory_pmr_;
+        rt_destroy_pmr_ = other.rt_destroy_pmr_;
         tr_factory_  = other.tr_factory_;
         tr_destroy_  = other.tr_destroy_;
         other.handle_ = nullptr;
         other.rt_factory_ = nullptr;
         other.rt_destroy_ = nullptr;
+        other.rt_factory_pmr_ = nullptr;
+        other.rt_destroy_pmr_ = nullptr;
         other.tr_factory_ = nullptr;
         other.tr_destroy_ = nullptr;
     }
@@ -96,25 +100,23 @@ PluginLibrary& PluginLibrary::operator=(PluginLibrary&& other) noexcept {
 void PluginLibrary::load_symbols() {
     if (!handle_) return;
 
-    try {
-        rt_factory_ = reinterpret_cast<RealtimeFactoryFn>(
-            load_symbol(handle_, KP_RT_FACTORY_NAME));
-        rt_destroy_ = reinterpret_cast<RealtimeDestroyFn>(
-            load_symbol(handle_, KP_RT_DESTROY_NAME));
-    } catch (const PluginError&) {
-        rt_factory_ = nullptr;
-        rt_destroy_ = nullptr;
-    }
-
-    try {
-        tr_factory_ = reinterpret_cast<TrainerFactoryFn>(
-            load_symbol(handle_, KP_TR_FACTORY_NAME));
-        tr_destroy_ = reinterpret_cast<TrainerDestroyFn>(
-            load_symbol(handle_, KP_TR_DESTROY_NAME));
-    } catch (const PluginError&) {
-        tr_factory_ = nullptr;
-        tr_destroy_ = nullptr;
-    }
+    // Each factory is only usable together with its destroy function.
+    auto load_pair = [this](const char* factory_name, const char* destroy_name,
+                            auto& factory, auto& destroy) {
+        void* f = find_symbol(handle_, factory_name);
+        void* d = find_symbol(handle_, destroy_name);
+        if (f && d) {
+            factory = reinterpret_cast<std::remove_reference_t<decltype(factory)>>(f);
+            destroy = reinterpret_cast<std::remove_reference_t<decltype(destroy)>>(d);
+        } else {
+            factory = nullptr;
+            destroy = nullptr;
+        }
+    };
+
+    load_pair(KP_RT_FACTORY_NAME, KP_RT_DESTROY_NAME, rt_factory_, rt_destroy_);
+    load_pair(KP_RT_FACTORY_PMR_NAME, KP_RT_DESTROY_PMR_NAME, rt_factory_pmr_, rt_destroy_pmr_);
+    load_pair(KP_TR_FACTORY_NAME, KP_TR_DESTROY_NAME, tr_factory_, tr_destroy_);
 
     if (!rt_factory_ && !tr_factory_) {
         throw PluginError("Plugin does not export any KronosXPredict factories");
@@ -133,6 +135,18 @@ PluginLibrary::create_realtime(const json& cfg) const {
     return std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>(raw, rt_destroy_);
 }
 
+std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>
+PluginLibrary::create_realtime(const json& cfg, std::pmr::memory_resource* mr) const {
+    if (!rt_factory_pmr_ || !rt_destroy_pmr_ || !mr) {
+        return create_realtime(cfg);
+    }
+    IRealtimeModel* raw = rt_factory_pmr_(cfg, mr);
+    if (!raw) {
+        throw PluginError("Realtime pmr factory returned null");
+    }
+    return std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>(raw, rt_destroy_pmr_);
+}
+
 std::unique_ptr<IModelTrainer, TrainerDestroyFn>
 PluginLibrary::create_trainer(const json& cfg) const {
     if (!tr_factory_ || !tr_destroy_) {
@@ -150,7 +164,7 @@ RealtimeModelInstance::RealtimeModelInstance(std::shared_ptr<PluginLibrary> lib,
     : lib_(std::move(lib)), model_(std::move(model)) {}
 
 std::shared_ptr<PluginLibrary> load_plugin_library(const std::string& path) {
-    return std::make_shared<PluginLibrary>(path);
+    return PluginRegistry::instance().library(path);
 }
 
 } // namespace KronosXPredict
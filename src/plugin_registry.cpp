@@ -0,0 +1,277 @@
+#include "KronosXPredict/plugin_registry.hpp"
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace KronosXPredict {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kManifestSuffix = ".manifest.json";
+
+std::string canonical_path(const fs::path& p) {
+    std::error_code ec;
+    fs::path c = fs::weakly_canonical(p, ec);
+    return ec ? p.string() : c.string();
+}
+
+ModelKind parse_model_kind(const std::string& s) {
+    if (s == "VARX")             return ModelKind::VARX;
+    if (s == "StateSpaceMLE")    return ModelKind::StateSpaceMLE;
+    if (s == "GARCHFamily")      return ModelKind::GARCHFamily;
+    if (s == "Hawkes")           return ModelKind::Hawkes;
+    if (s == "KernelNonlinear")  return ModelKind::KernelNonlinear;
+    if (s == "GradientBoosting") return ModelKind::GradientBoosting;
+    if (s == "NeuralNet")        return ModelKind::NeuralNet;
+    if (s == "Custom")           return ModelKind::Custom;
+    throw PluginError("Unknown model kind in manifest: " + s);
+}
+
+PluginManifest read_manifest(const fs::path& file) {
+    std::ifstream in(file);
+    if (!in) {
+        throw PluginError("Failed to open plugin manifest");
+    }
+    try {
+        json j = json::parse(in);
+        PluginManifest m;
+        m.name        = j.at("name").get<std::string>();
+        m.library     = canonical_path(file.parent_path() / j.at("library").get<std::string>());
+        m.abi_version = j.value("abi_version", 0);
+        m.precision   = j.value("precision", std::string("float64"));
+        for (const auto& k : j.value("model_kinds", json::array())) {
+            m.model_kinds.push_back(parse_model_kind(k.get<std::string>()));
+        }
+        for (const auto& p : j.value("provides", json::array())) {
+            const auto what = p.get<std::string>();
+            if (what == "realtime")     m.provides_realtime     = true;
+            if (what == "realtime_pmr") m.provides_realtime_pmr = true;
+            if (what == "trainer")      m.provides_trainer      = true;
+        }
+        return m;
+    } catch (const json::exception& e) {
+        throw PluginError(std::string("Malformed plugin manifest: ") + e.what());
+    }
+}
+
+// Runs fn(0..n-1) on up to `threads` workers. fn must not throw.
+template <typename Fn>
+void parallel_for(std::size_t n, unsigned threads, Fn&& fn) {
+    if (n == 0) return;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = std::min<std::size_t>(threads, n);
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&] {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t = 1; t < workers; ++t) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+}
+
+} // namespace
+
+PluginRegistry& PluginRegistry::instance() {
+    static PluginRegistry registry;
+    return registry;
+}
+
+PluginScanResult PluginRegistry::scan(const std::string& dir) {
+    const auto start = Clock::now();
+
+    std::error_code ec;
+    fs::directory_iterator it(dir, ec);
+    if (ec) {
+        throw PluginError("Failed to scan plugin directory " + dir + ": " + ec.message());
+    }
+
+    PluginScanResult res;
+    std::vector<PluginManifest> found;
+    for (const auto& entry : it) {
+        const std::string fname = entry.path().filename().string();
+        if (!entry.is_regular_file() || fname.size() <= std::strlen(kManifestSuffix) ||
+            fname.compare(fname.size() - std::strlen(kManifestSuffix),
+                          std::string::npos, kManifestSuffix) != 0) {
+            continue;
+        }
+        // One bad manifest must not hide the rest of the directory.
+        try {
+            found.push_back(read_manifest(entry.path()));
+        } catch (const PluginError& e) {
+            res.errors.push_back(entry.path().string() + ": " + e.what());
+        }
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    for (auto& m : found) {
+        by_library_[m.library] = m.name;
+        manifests_[m.name] = std::move(m);
+    }
+    res.registered = found.size();
+    last_scan_ = Clock::now() - start;
+    return res;
+}
+
+bool PluginRegistry::forget(const std::string& name) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = manifests_.find(name);
+    if (it == manifests_.end()) return false;
+    auto lib = by_library_.find(it->second.library);
+    if (lib != by_library_.end() && lib->second == name) {
+        by_library_.erase(lib);
+    }
+    manifests_.erase(it);
+    return true;
+}
+
+std::vector<PluginManifest> PluginRegistry::manifests() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::vector<PluginManifest> out;
+    for (const auto& [name, m] : manifests_) out.push_back(m);
+    return out;
+}
+
+std::optional<PluginManifest> PluginRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = manifests_.find(name);
+    if (it == manifests_.end()) return std::nullopt;
+    return it->second;
+}
+
+std::vector<PluginManifest> PluginRegistry::find_by_kind(ModelKind kind) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::vector<PluginManifest> out;
+    for (const auto& [name, m] : manifests_) {
+        if (std::find(m.model_kinds.begin(), m.model_kinds.end(), kind) != m.model_kinds.end()) {
+            out.push_back(m);
+        }
+    }
+    return out;
+}
+
+Clock::duration PluginRegistry::last_scan_duration() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return last_scan_;
+}
+
+std::string PluginRegistry::resolve(const std::string& plugin) const {
+    const PluginManifest* m = nullptr;
+    std::string path;
+
+    if (auto it = manifests_.find(plugin); it != manifests_.end()) {
+        m = &it->second;
+        path = m->library;
+    } else {
+        path = canonical_path(plugin);
+        if (auto lib = by_library_.find(path); lib != by_library_.end()) {
+            m = &manifests_.at(lib->second);
+        }
+    }
+
+    if (m && !m->compatible()) {
+        throw PluginError("Plugin " + m->name + " was built for ABI version " +
+                          std::to_string(m->abi_version) + ", host is " +
+                          std::to_string(KP_ABI_VERSION));
+    }
+    return path;
+}
+
+std::shared_ptr<PluginLibrary> PluginRegistry::library(const std::string& plugin) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        path = resolve(plugin);
+        if (auto it = libraries_.find(path); it != libraries_.end()) {
+            return it->second;
+        }
+    }
+
+    // Open outside the lock so distinct libraries load in parallel.
+    auto lib = std::make_shared<PluginLibrary>(path);
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return libraries_.emplace(path, std::move(lib)).first->second;
+}
+
+WarmStartResult PluginRegistry::warm_start(const std::vector<ModelSpec>& specs,
+                                           unsigned threads) {
+    const auto start = Clock::now();
+    const std::size_t n = specs.size();
+
+    WarmStartResult res;
+    res.instances.resize(n);
+    res.errors.resize(n);
+
+    // Phase 1: each distinct library once.
+    std::vector<std::string> plugins;
+    std::vector<std::size_t> lib_of(n);
+    {
+        std::unordered_map<std::string, std::size_t> index;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto [it, inserted] = index.emplace(specs[i].plugin, plugins.size());
+            if (inserted) plugins.push_back(specs[i].plugin);
+            lib_of[i] = it->second;
+        }
+    }
+    std::vector<std::shared_ptr<PluginLibrary>> libs(plugins.size());
+    std::vector<std::string> lib_errors(plugins.size());
+    parallel_for(plugins.size(), threads, [&](std::size_t i) {
+        try {
+            libs[i] = library(plugins[i]);
+        } catch (const std::exception& e) {
+            lib_errors[i] = e.what();
+        }
+    });
+    const auto loaded = Clock::now();
+
+    // Phase 2: factories.
+    parallel_for(n, threads, [&](std::size_t i) {
+        const auto& lib = libs[lib_of[i]];
+        if (!lib) {
+            res.errors[i] = lib_errors[lib_of[i]];
+            return;
+        }
+        try {
+            auto model = specs[i].resource
+                ? lib->create_realtime(specs[i].config, specs[i].resource)
+                : lib->create_realtime(specs[i].config);
+            res.instances[i] = std::make_shared<RealtimeModelInstance>(lib, std::move(model));
+        } catch (const std::exception& e) {
+            res.errors[i] = e.what();
+        }
+    });
+    const auto created = Clock::now();
+
+    // Phase 3: warmup.
+    parallel_for(n, threads, [&](std::size_t i) {
+        if (!res.instances[i] || !specs[i].warmup) return;
+        try {
+            specs[i].warmup(res.instances[i]->model());
+        } catch (const std::exception& e) {
+            res.errors[i] = e.what();
+            res.instances[i].reset();
+        }
+    });
+    const auto warmed = Clock::now();
+
+    res.timings.load   = loaded - start;
+    res.timings.create = created - loaded;
+    res.timings.warmup = warmed - created;
+    res.timings.total  = warmed - start;
+    return res;
+}
+
+} // namespace KronosXPredict
@@ -0,0 +1,252 @@
+#include "KronosXPredict/prediction_service.hpp"
+
+#include <algorithm>
+
+namespace KronosXPredict {
+
+namespace {
+
+PredictionService::Future ready_future(PredictionResult r) {
+    std::promise<PredictionResult> p;
+    p.set_value(std::move(r));
+    return p.get_future().share();
+}
+
+PredictionService::Future failed_future(std::exception_ptr e) {
+    std::promise<PredictionResult> p;
+    p.set_exception(std::move(e));
+    return p.get_future().share();
+}
+
+PredictionResult mark_stale(PredictionResult r) {
+    r.scalars["stale"] = 1.0;
+    return r;
+}
+
+} // namespace
+
+PredictionService::PredictionService(std::shared_ptr<RealtimeModelInstance> instance,
+                                     PredictionServiceOptions opts)
+    : instance_(std::move(instance)), opts_(opts) {
+    if (!instance_) {
+        throw std::invalid_argument("PredictionService requires a model instance");
+    }
+    worker_  = std::thread([this] { run(); });
+    expirer_ = std::thread([this] { expire_loop(); });
+}
+
+PredictionService::~PredictionService() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    timer_cv_.notify_all();
+    worker_.join();
+    expirer_.join();
+}
+
+void PredictionService::ingest(const Observation& obs) {
+    std::lock_guard<std::mutex> ml(model_mutex_);
+    instance_->model().ingest(obs);
+    std::lock_guard<std::mutex> lk(mutex_);
+    ++tick_;
+}
+
+bool PredictionService::ready() const {
+    std::lock_guard<std::mutex> ml(model_mutex_);
+    return instance_->model().ready();
+}
+
+PredictionService::Future PredictionService::submit(const PredictionRequest& req,
+                                                    TimePoint deadline) {
+    const Shape shape = shape_of(req);
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    ++metrics_.submitted;
+
+    auto cached = cache_.find(shape);
+    if (cached != cache_.end() && cached->second.tick == tick_) {
+        ++metrics_.coalesced;
+        return ready_future(cached->second.result);
+    }
+
+    auto inflight = inflight_.find({shape, tick_});
+    if (inflight != inflight_.end()) {
+        const auto& group = inflight->second;
+        if (deadline == group->deadline) {
+            ++metrics_.coalesced;
+            return group->future;
+        }
+        // The group's deadline cannot stand in for ours. An earlier one is
+        // answered now from the last result; otherwise we queue behind the
+        // group with our own deadline and the worker answers us from its result.
+        if (deadline < group->deadline && opts_.serve_stale && cached != cache_.end()) {
+            ++metrics_.served_stale;
+            return ready_future(mark_stale(cached->second.result));
+        }
+    }
+
+    if (Clock::now() > deadline || queue_.size() >= opts_.max_queue_depth) {
+        if (opts_.serve_stale && cached != cache_.end()) {
+            ++metrics_.served_stale;
+            return ready_future(mark_stale(cached->second.result));
+        }
+        ++metrics_.shed;
+        return failed_future(std::make_exception_ptr(PredictionShed(
+            Clock::now() > deadline ? "Prediction deadline exceeded"
+                                    : "Prediction queue full")));
+    }
+
+    auto p = std::make_shared<Pending>();
+    p->shape    = shape;
+    p->tick     = tick_;
+    p->deadline = deadline;
+    p->req      = req;
+    // Results are shared between coalesced callers, so they cannot live in any
+    // one caller's resource.
+    p->req.result_resource = std::pmr::get_default_resource();
+    p->future   = p->promise.get_future().share();
+
+    queue_.push_back(p);
+    inflight_.emplace(std::make_pair(shape, tick_), p); // no-op when joining a group
+    metrics_.queue_depth = queue_.size();
+    cv_.notify_one();
+    timer_cv_.notify_one();
+    return p->future;
+}
+
+PredictionServiceMetrics PredictionService::metrics() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return metrics_;
+}
+
+void PredictionService::release(const Pending& p) {
+    auto it = inflight_.find({p.shape, p.tick});
+    if (it != inflight_.end() && it->second.get() == &p) {
+        inflight_.erase(it);
+    }
+}
+
+void PredictionService::fulfill(Pending& p, PredictionResult r) {
+    if (p.done) return;
+    p.done = true;
+    p.promise.set_value(std::move(r));
+}
+
+void PredictionService::fail(Pending& p, std::exception_ptr e) {
+    if (p.done) return;
+    p.done = true;
+    p.promise.set_exception(std::move(e));
+}
+
+bool PredictionService::answer_fresh(Pending& p) {
+    auto cached = cache_.find(p.shape);
+    if (cached == cache_.end() || cached->second.tick < p.tick) return false;
+    release(p);
+    ++metrics_.coalesced;
+    fulfill(p, cached->second.result);
+    return true;
+}
+
+void PredictionService::expire(Pending& p) {
+    release(p);
+    auto cached = cache_.find(p.shape);
+    if (opts_.serve_stale && cached != cache_.end()) {
+        ++metrics_.served_stale;
+        fulfill(p, mark_stale(cached->second.result));
+    } else {
+        ++metrics_.shed;
+        fail(p, std::make_exception_ptr(PredictionShed("Prediction deadline exceeded")));
+    }
+}
+
+void PredictionService::run() {
+    for (;;) {
+        std::shared_ptr<Pending> p;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            cv_.wait(lk, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) break;
+            p = std::move(queue_.front());
+            queue_.pop_front();
+            metrics_.queue_depth = queue_.size();
+
+            // A fresh result wins over the deadline; only a computation can miss it.
+            if (answer_fresh(*p)) continue;
+            if (Clock::now() > p->deadline) {
+                expire(*p);
+                continue;
+            }
+            current_ = p;
+        }
+
+        try {
+            std::unique_lock<std::mutex> ml(model_mutex_);
+            std::uint64_t tick;
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                tick = tick_;
+            }
+            PredictionResult r = instance_->model().predict(p->req);
+            ml.unlock();
+
+            std::lock_guard<std::mutex> lk(mutex_);
+            current_.reset();
+            release(*p);
+            cache_.insert_or_assign(p->shape, Cached{tick, r});
+            ++metrics_.computed;
+            fulfill(*p, std::move(r)); // no-op if it already expired
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(mutex_);
+            current_.reset();
+            release(*p);
+            fail(*p, std::current_exception());
+        }
+    }
+
+    // Anything still queued at shutdown is shed.
+    std::lock_guard<std::mutex> lk(mutex_);
+    inflight_.clear();
+    metrics_.shed += queue_.size();
+    metrics_.queue_depth = 0;
+    for (auto& p : queue_) {
+        fail(*p, std::make_exception_ptr(PredictionShed("PredictionService stopped")));
+    }
+    queue_.clear();
+}
+
+void PredictionService::expire_loop() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    while (!stopping_) {
+        const auto now = Clock::now();
+        TimePoint next = TimePoint::max();
+
+        for (auto it = queue_.begin(); it != queue_.end();) {
+            Pending& p = **it;
+            if (now > p.deadline) {
+                if (!answer_fresh(p)) expire(p);
+                it = queue_.erase(it);
+                continue;
+            }
+            next = std::min(next, p.deadline);
+            ++it;
+        }
+        metrics_.queue_depth = queue_.size();
+
+        // The request in predict() keeps its deadline too; the worker still
+        // caches the result when the call returns.
+        if (current_ && !current_->done) {
+            if (now > current_->deadline) expire(*current_);
+            else next = std::min(next, current_->deadline);
+        }
+
+        if (next == TimePoint::max()) {
+            timer_cv_.wait(lk);
+        } else {
+            timer_cv_.wait_until(lk, next + std::chrono::microseconds(1));
+        }
+    }
+}
+
+} // namespace KronosXPredict
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "KronosXPredict/alignment.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace KronosXPredict;
+
+namespace {
+
+TimePoint at(long ns) {
+    return TimePoint(std::chrono::nanoseconds(ns));
+}
+
+struct Row {
+    TimePoint         t;
+    std::vector<Real> endogenous;
+    std::vector<Real> exogenous;
+};
+
+AsOfAligner::Sink collect(std::vector<Row>& rows) {
+    return [&rows](const Observation& obs) {
+        rows.push_back(Row{obs.t,
+                           {obs.endogenous.begin(), obs.endogenous.end()},
+                           {obs.exogenous.begin(), obs.exogenous.end()}});
+    };
+}
+
+class VectorEventSource : public IEventSource {
+public:
+    VectorEventSource(std::vector<std::pair<long, std::vector<Real>>> events)
+        : events_(std::move(events)) {}
+
+    bool next(StreamEvent& out) override {
+        if (i_ == events_.size()) return false;
+        out.t      = at(events_[i_].first);
+        out.values = events_[i_].second;
+        ++i_;
+        return true;
+    }
+
+private:
+    std::vector<std::pair<long, std::vector<Real>>> events_;
+    std::size_t i_ = 0;
+};
+
+} // namespace
+
+TEST(AsOfAlignerTest, ReplayMergesStreamsAsOf) {
+    // quotes -> endogenous[0..1], rates -> exogenous[0]
+    AsOfAligner aligner({{2, ColumnBlock::Endogenous, 0}, {1, ColumnBlock::Exogenous, 0}});
+    ASSERT_EQ(aligner.dim_endogenous(), 2u);
+    ASSERT_EQ(aligner.dim_exogenous(), 1u);
+
+    VectorEventSource quotes({{10, {1.0, 1.1}}, {30, {2.0, 2.1}}, {50, {3.0, 3.1}}});
+    VectorEventSource rates({{20, {0.05}}, {40, {0.06}}});
+    IEventSource* sources[] = {&quotes, &rates};
+
+    std::vector<Row> rows;
+    EXPECT_EQ(aligner.replay(sources, collect(rows)), 5u);
+
+    // Nothing until both streams have a value (t = 20).
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[0].t, at(20));
+    EXPECT_DOUBLE_EQ(rows[0].endogenous[0], 1.0);
+    EXPECT_DOUBLE_EQ(rows[0].exogenous[0], 0.05);
+    EXPECT_EQ(rows[2].t, at(40));
+    EXPECT_DOUBLE_EQ(rows[2].endogenous[1], 2.1);
+    EXPECT_DOUBLE_EQ(rows[2].exogenous[0], 0.06);
+    EXPECT_DOUBLE_EQ(rows[3].endogenous[0], 3.0);
+}
+
+TEST(AsOfAlignerTest, StreamTrigger) {
+    AlignerConfig cfg;
+    cfg.trigger        = AlignTrigger::Stream;
+    cfg.trigger_stream = 1;
+    AsOfAligner aligner({{1}, {1, ColumnBlock::Endogenous, 1}}, cfg);
+
+    std::vector<Row> rows;
+    auto sink = collect(rows);
+    const Real a1[] = {1.0}, a2[] = {2.0}, b1[] = {10.0};
+    aligner.on_event(0, at(1), a1, sink);
+    aligner.on_event(0, at(2), a2, sink);
+    aligner.on_event(1, at(3), b1, sink);
+
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_DOUBLE_EQ(rows[0].endogenous[0], 2.0);
+    EXPECT_DOUBLE_EQ(rows[0].endogenous[1], 10.0);
+}
+
+TEST(AsOfAlignerTest, GridTriggerSeesStateAsOfGridPoint) {
+    AlignerConfig cfg;
+    cfg.trigger   = AlignTrigger::Grid;
+    cfg.grid_step = std::chrono::nanoseconds(10);
+    AsOfAligner aligner({StreamLayout{1}}, cfg);
+
+    std::vector<Row> rows;
+    auto sink = collect(rows);
+    const Real v1[] = {1.0}, v2[] = {2.0}, v3[] = {3.0};
+    aligner.on_event(0, at(10), v1, sink); // grid 10 pending
+    aligner.on_event(0, at(25), v2, sink); // emits 10, 20 with v1
+    aligner.on_event(0, at(30), v3, sink); // 30 pending
+    aligner.advance_to(at(41), sink);      // emits 30, 40 with v3
+
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[0].t, at(10));
+    EXPECT_DOUBLE_EQ(rows[1].endogenous[0], 1.0);
+    EXPECT_EQ(rows[2].t, at(30));
+    EXPECT_DOUBLE_EQ(rows[2].endogenous[0], 3.0);
+    EXPECT_EQ(rows[3].t, at(40));
+}
+
+TEST(AsOfAlignerTest, CsvReplay) {
+    const std::string path = "test_alignment_events.csv";
+    {
+        std::ofstream out(path);
+        out << "# t,bid,ask\n10,1.5,1.6\n\n30,1.7,1.8\n";
+    }
+
+    CsvEventSource src(path);
+    AsOfAligner aligner({StreamLayout{2}});
+    IEventSource* sources[] = {&src};
+
+    std::vector<Row> rows;
+    EXPECT_EQ(aligner.replay(sources, collect(rows)), 2u);
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[1].t, at(30));
+    EXPECT_DOUBLE_EQ(rows[1].endogenous[1], 1.8);
+    std::remove(path.c_str());
+}
+
+TEST(AsOfAlignerTest, GridReplayEmitsPointAtLastEvent) {
+    AlignerConfig cfg;
+    cfg.trigger   = AlignTrigger::Grid;
+    cfg.grid_step = std::chrono::nanoseconds(10);
+    AsOfAligner aligner({StreamLayout{1}}, cfg);
+
+    VectorEventSource src({{10, {1.0}}, {25, {2.0}}, {30, {3.0}}});
+    IEventSource* sources[] = {&src};
+
+    std::vector<Row> rows;
+    EXPECT_EQ(aligner.replay(sources, collect(rows)), 3u);
+    ASSERT_EQ(rows.size(), 3u);
+    EXPECT_EQ(rows[2].t, at(30));
+    EXPECT_DOUBLE_EQ(rows[2].endogenous[0], 3.0);
+}
+
+TEST(AsOfAlignerTest, CsvRejectsTrailingJunk) {
+    const std::string path = "test_alignment_junk.csv";
+    {
+        std::ofstream out(path);
+        out << "10,1.5 \r\n20,1.5abc\n";
+    }
+
+    CsvEventSource src(path);
+    StreamEvent ev;
+    ASSERT_TRUE(src.next(ev)); // trailing whitespace is fine
+    EXPECT_DOUBLE_EQ(ev.values[0], 1.5);
+    EXPECT_THROW(src.next(ev), AlignmentError);
+    std::remove(path.c_str());
+}
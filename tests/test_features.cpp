@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "KronosXPredict/features.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using json = nlohmann::json;
+using namespace KronosXPredict;
+
+namespace {
+
+Observation make_obs(long t, const std::vector<Real>& e, const std::vector<Real>& x) {
+    return Observation{
+        TimePoint(std::chrono::nanoseconds(t)),
+        std::span<const Real>(e.data(), e.size()),
+        std::span<const Real>(x.data(), x.size())
+    };
+}
+
+std::string stub_path() {
+#if defined(_WIN32)
+    return "plugins/stub/KronosXPredict_stub.dll";
+#elif defined(__APPLE__)
+    return "plugins/stub/libKronosXPredict_stub.dylib";
+#else
+    return "plugins/stub/libKronosXPredict_stub.so";
+#endif
+}
+
+} // namespace
+
+TEST(FeatureChainTest, FusedLogReturnAndRollingVol) {
+    FeatureChain chain({{FeatureOp::LogReturn, 1}, {FeatureOp::RollingVol, 3}});
+
+    const std::vector<Real> prices{100.0, 101.0, 99.0, 102.0, 103.0};
+    std::vector<Real> returns;
+    std::span<const Real> out;
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        std::vector<Real> row{prices[i]};
+        out = chain.push(row);
+        if (i > 0) returns.push_back(std::log(prices[i] / prices[i - 1]));
+        // One price to seed the return, three returns to fill the window.
+        EXPECT_EQ(chain.ready(), i >= 3) << "tick " << i;
+    }
+
+    // Sample stddev of the last three returns.
+    const Real mean = (returns[1] + returns[2] + returns[3]) / 3.0;
+    Real var = 0.0;
+    for (int k = 1; k <= 3; ++k) var += (returns[k] - mean) * (returns[k] - mean);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_NEAR(out[0], std::sqrt(var / 2.0), 1e-12);
+}
+
+TEST(FeatureChainTest, LagWidensRow) {
+    FeatureChain chain({{FeatureOp::Diff, 1}, {FeatureOp::Lag, 2}});
+
+    std::span<const Real> out;
+    for (Real v : {1.0, 3.0, 6.0, 10.0}) {
+        std::vector<Real> row{v, -v};
+        out = chain.push(row);
+    }
+    ASSERT_TRUE(chain.ready());
+    ASSERT_EQ(out.size(), 6u);
+    // Column 0 diffs: 2, 3, 4 -> [4, 3, 2]; column 1 is the negation.
+    EXPECT_DOUBLE_EQ(out[0], 4.0);
+    EXPECT_DOUBLE_EQ(out[1], 3.0);
+    EXPECT_DOUBLE_EQ(out[2], 2.0);
+    EXPECT_DOUBLE_EQ(out[3], -4.0);
+    EXPECT_DOUBLE_EQ(out[5], -2.0);
+}
+
+TEST(FeaturePipelineTest, SharedPipelineComputesOncePerTick) {
+    auto lib = load_plugin_library(stub_path());
+
+    json cfg;
+    cfg["warmup_count"] = 1;
+    cfg["features"] = {
+        {"instrument", "ESZ5"},
+        {"endogenous", json::array({ {{"op", "diff"}} })}
+    };
+
+    FeaturePipelineRegistry registry;
+    auto a = create_realtime_with_features(*lib, cfg, registry);
+    auto b = create_realtime_with_features(*lib, cfg, registry);
+    auto pipeline = registry.acquire(cfg["features"]);
+    EXPECT_EQ(pipeline, registry.acquire(cfg["features"]));
+
+    std::vector<Real> x{};
+    std::vector<Real> e1{10.0};
+    EXPECT_TRUE(pipeline->push(1, make_obs(1, e1, x)));
+    EXPECT_FALSE(a->ready());
+
+    std::vector<Real> e2{12.5};
+    EXPECT_TRUE(pipeline->push(2, make_obs(2, e2, x)));
+    ASSERT_TRUE(a->ready());
+    ASSERT_TRUE(b->ready());
+
+    // A duplicated or replayed tick does not advance the shared state.
+    EXPECT_FALSE(pipeline->push(2, make_obs(2, e2, x)));
+    EXPECT_FALSE(pipeline->push(1, make_obs(1, e1, x)));
+    EXPECT_EQ(pipeline->computed(), 2u);
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Return;
+    EXPECT_DOUBLE_EQ(a->predict(req).mean[0], 2.5);
+    EXPECT_DOUBLE_EQ(b->predict(req).mean[0], 2.5);
+    EXPECT_DOUBLE_EQ(b->predict(req).scalars.at("count"), 1.0);
+
+    // Raw data must go through the pipeline.
+    EXPECT_THROW(a->ingest(make_obs(3, e2, x)), FeatureError);
+}
+
+TEST(FeaturePipelineTest, InstrumentsGetSeparatePipelines) {
+    json spec = {{"endogenous", json::array({ {{"op", "diff"}} })}};
+
+    FeaturePipelineRegistry registry;
+    EXPECT_THROW(registry.acquire(spec), FeatureError);
+    EXPECT_THROW(FeaturePipeline::from_json(spec), FeatureError);
+
+    spec["instrument"] = "ESZ5";
+    auto es = registry.acquire(spec);
+    spec["instrument"] = "NQZ5";
+    auto nq = registry.acquire(spec);
+    EXPECT_NE(es, nq);
+
+    spec["instrument"] = 5;
+    EXPECT_THROW(registry.acquire(spec), FeatureError);
+}
+
+TEST(FeaturePipelineTest, RepeatedTimestampsAreDistinctTicks) {
+    auto lib = load_plugin_library(stub_path());
+
+    json cfg;
+    cfg["warmup_count"] = 1;
+    cfg["features"] = {{"instrument", "ESZ5"}}; // passthrough
+
+    FeaturePipelineRegistry registry;
+    auto model = create_realtime_with_features(*lib, cfg, registry);
+    auto pipeline = registry.acquire(cfg["features"]);
+
+    std::vector<Real> x{};
+    std::uint64_t seq = 0;
+    for (Real v : {1.0, 2.0, 3.0}) {
+        std::vector<Real> e{v};
+        ASSERT_TRUE(pipeline->push(++seq, Observation{TimePoint{}, e, x}));
+    }
+    EXPECT_EQ(pipeline->computed(), 3u);
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Price;
+    EXPECT_DOUBLE_EQ(model->predict(req).mean[0], 3.0);
+    EXPECT_DOUBLE_EQ(model->predict(req).scalars.at("count"), 3.0);
+}
+
+TEST(FeaturePipelineTest, FeedAndModelsOnSeparateThreads) {
+    auto lib = load_plugin_library(stub_path());
+
+    json cfg;
+    cfg["warmup_count"] = 1;
+    cfg["features"] = {
+        {"instrument", "ESZ5"},
+        {"endogenous", json::array({ {{"op", "diff"}} })}
+    };
+
+    FeaturePipelineRegistry registry;
+    auto pipeline = registry.acquire(cfg["features"]);
+    std::vector<std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>> models;
+    for (int i = 0; i < 2; ++i) {
+        models.push_back(create_realtime_with_features(*lib, cfg, registry));
+    }
+
+    constexpr int kTicks = 2000;
+    std::atomic<bool> done{false};
+    std::thread feed([&] {
+        std::vector<Real> x{};
+        for (int i = 1; i <= kTicks; ++i) {
+            std::vector<Real> e{static_cast<Real>(i) * i};
+            pipeline->push(static_cast<std::uint64_t>(i), make_obs(i, e, x));
+        }
+        done = true;
+    });
+    PredictionRequest req;
+    req.target_kind = TargetKind::Return;
+    std::vector<std::thread> readers;
+    for (auto& m : models) {
+        readers.emplace_back([&done, &req, model = m.get()] {
+            while (!done) {
+                if (model->ready()) (void)model->predict(req);
+            }
+        });
+    }
+    feed.join();
+    for (auto& t : readers) t.join();
+
+    for (auto& m : models) {
+        // Last diff: kTicks^2 - (kTicks - 1)^2.
+        EXPECT_DOUBLE_EQ(m->predict(req).mean[0], 2.0 * kTicks - 1.0);
+        // Every row after the diff warm-up reached the model exactly once.
+        EXPECT_DOUBLE_EQ(m->predict(req).scalars.at("count"), kTicks - 1.0);
+    }
+    EXPECT_EQ(pipeline->computed(), static_cast<std::uint64_t>(kTicks));
+}
+
+TEST(FeaturePipelineTest, RejectsBadSpec) {
+    EXPECT_THROW(FeaturePipeline::from_json(json::parse(R"({"instrument":"X","endogenous":[{"op":"nope"}]})")),
+                 FeatureError);
+    EXPECT_THROW(FeaturePipeline::from_json(json::parse(R"({"instrument":"X","endogenous":[{"op":"zscore"}]})")),
+                 FeatureError);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "KronosXPredict/ipc.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+using namespace KronosXPredict;
+
+namespace {
+
+std::shared_ptr<RealtimeModelInstance> make_stub_instance() {
+    auto lib = load_plugin_library("plugins/stub/libKronosXPredict_stub.so");
+    json cfg;
+    cfg["warmup_count"] = 2;
+    auto model = lib->create_realtime(cfg);
+    return std::make_shared<RealtimeModelInstance>(lib, std::move(model));
+}
+
+std::string socket_path() {
+    return "/tmp/kxp_test_" + std::to_string(::getpid()) + ".sock";
+}
+
+// Returns a variance one element longer than the mean.
+class BadVarianceModel : public IRealtimeModel {
+public:
+    void ingest(const Observation&) override {}
+    bool ready() const noexcept override { return true; }
+    PredictionResult predict(const PredictionRequest&) const override {
+        PredictionResult r;
+        r.mean.assign(2, 1.0);
+        r.emplace_variance(3);
+        return r;
+    }
+    void reset() override {}
+    ModelKind kind() const noexcept override { return ModelKind::Custom; }
+};
+
+void destroy_model(IRealtimeModel* m) { delete m; }
+
+} // namespace
+
+TEST(IpcTest, ClientsShareHostedModel) {
+    IpcServer server(socket_path());
+    server.add_model("stub", make_stub_instance());
+    server.start();
+
+    IpcClient publisher(server.socket_path(), "stub");
+    IpcClient reader(server.socket_path(), "stub");
+
+    std::vector<Real> e{1.5, 2.5};
+    std::vector<Real> x{9.0};
+    Observation obs{
+        TimePoint(std::chrono::nanoseconds(42)),
+        std::span<const Real>(e.data(), e.size()),
+        std::span<const Real>(x.data(), x.size())
+    };
+    publisher.ingest(obs);
+    EXPECT_FALSE(publisher.ready());
+    publisher.ingest(obs);
+    EXPECT_TRUE(publisher.ready());
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Return;
+    req.steps_ahead = 3;
+    auto r = reader.predict(req);
+    ASSERT_EQ(r.mean.size(), 2u);
+    EXPECT_DOUBLE_EQ(r.mean[0], 1.5);
+    EXPECT_DOUBLE_EQ(r.mean[1], 2.5);
+    EXPECT_EQ(r.steps_ahead, 3);
+    EXPECT_EQ(r.target_kind, TargetKind::Return);
+    EXPECT_EQ(r.based_on, obs.t);
+    ASSERT_TRUE(r.variance.has_value());
+    EXPECT_EQ(r.variance->size(), 2u);
+    ASSERT_EQ(r.scalars.count("count"), 1u);
+    EXPECT_DOUBLE_EQ(r.scalars.at("count"), 2.0);
+
+    server.stop();
+}
+
+TEST(IpcTest, SilentClientDoesNotBlockOthers) {
+    IpcServer server(socket_path());
+    server.add_model("stub", make_stub_instance());
+    server.start();
+
+    // Connects and never sends OPEN.
+    int idle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, server.socket_path().c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(::connect(idle, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+    const auto t0 = Clock::now();
+    IpcClient client(server.socket_path(), "stub", std::chrono::milliseconds(500));
+    EXPECT_LT(Clock::now() - t0, std::chrono::milliseconds(500));
+    EXPECT_FALSE(client.ready());
+
+    // The segment name is gone once the client has mapped it.
+    std::size_t names = 0;
+    const std::string prefix = "kxp." + std::to_string(::getpid()) + ".";
+    for (const auto& e : std::filesystem::directory_iterator("/dev/shm")) {
+        if (e.path().filename().string().rfind(prefix, 0) == 0) ++names;
+    }
+    EXPECT_EQ(names, 0u);
+
+    ::close(idle);
+}
+
+TEST(IpcTest, UnknownModelIsRefused) {
+    IpcServer server(socket_path());
+    server.add_model("stub", make_stub_instance());
+    server.start();
+
+    EXPECT_THROW(IpcClient(server.socket_path(), "missing"), IpcError);
+}
+
+TEST(IpcTest, ResultThatDoesNotFitIsAnError) {
+    IpcServer server(socket_path());
+    server.add_model("bad", std::make_shared<RealtimeModelInstance>(
+        nullptr,
+        std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>(new BadVarianceModel, &destroy_model)));
+    server.start();
+
+    IpcClient client(server.socket_path(), "bad");
+    PredictionRequest req;
+    req.target_kind = TargetKind::Price;
+    EXPECT_THROW(client.predict(req), IpcError);
+    EXPECT_TRUE(client.ready()); // the session survives the error
+}
+
+// Records p50/p99 of the shared-memory round trip. Wall-clock budgets are not
+// stable on shared runners, so the median is only checked against
+// KXP_IPC_P50_BUDGET_US when that is set.
+TEST(IpcTest, RoundTripLatency) {
+    IpcServer server(socket_path());
+    server.add_model("stub", make_stub_instance());
+    server.start();
+    IpcClient client(server.socket_path(), "stub");
+
+    std::vector<Real> e{1.0, 2.0, 3.0};
+    Observation obs{Clock::now(), std::span<const Real>(e.data(), e.size()), {}};
+    client.ingest(obs);
+    client.ingest(obs);
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Return;
+    for (int i = 0; i < 1000; ++i) client.predict(req);
+
+    std::vector<double> us;
+    for (int i = 0; i < 5000; ++i) {
+        const auto t0 = Clock::now();
+        client.predict(req);
+        us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+    }
+    std::sort(us.begin(), us.end());
+    const double p50 = us[us.size() / 2];
+    const double p99 = us[us.size() * 99 / 100];
+    RecordProperty("p50_us", std::to_string(p50));
+    RecordProperty("p99_us", std::to_string(p99));
+
+    if (const char* budget = std::getenv("KXP_IPC_P50_BUDGET_US")) {
+        EXPECT_LT(p50, std::atof(budget)) << "p99 " << p99 << " us";
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "KronosXPredict/memory.hpp"
+#include "KronosXPredict/plugin_loader.hpp"
+
+using json = nlohmann::json;
+using namespace KronosXPredict;
+
+namespace {
+
+std::string stub_path() {
+#if defined(_WIN32)
+    return "plugins/stub/KronosXPredict_stub.dll";
+#elif defined(__APPLE__)
+    return "plugins/stub/libKronosXPredict_stub.dylib";
+#else
+    return "plugins/stub/libKronosXPredict_stub.so";
+#endif
+}
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t live = 0;
+    std::size_t total = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        live += bytes;
+        total += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+TEST(ModelArenaTest, ModelAndResultUseCallerResources) {
+    auto lib = load_plugin_library(stub_path());
+    json cfg;
+    cfg["warmup_count"] = 1;
+
+    CountingResource model_mem;
+    CountingResource result_mem;
+    {
+        auto model = lib->create_realtime(cfg, &model_mem);
+        EXPECT_GT(model_mem.live, 0u);
+
+        std::vector<Real> e{1.0, 2.0, 3.0};
+        std::vector<Real> x{};
+        model->ingest(Observation{
+            TimePoint{},
+            std::span<const Real>(e.data(), e.size()),
+            std::span<const Real>(x.data(), x.size())
+        });
+
+        PredictionRequest req;
+        req.target_kind     = TargetKind::Return;
+        req.result_resource = &result_mem;
+        auto r = model->predict(req);
+        EXPECT_EQ(r.mean.get_allocator().resource(), &result_mem);
+        EXPECT_EQ(r.variance->get_allocator().resource(), &result_mem);
+        EXPECT_DOUBLE_EQ(r.mean[2], 3.0);
+        EXPECT_GT(result_mem.live, 0u);
+    }
+    EXPECT_EQ(model_mem.live, 0u);
+    EXPECT_EQ(result_mem.live, 0u);
+}
+
+TEST(ModelArenaTest, ShardOfModelsFromOneArena) {
+    auto lib = load_plugin_library(stub_path());
+    json cfg;
+    cfg["warmup_count"] = 1;
+
+    ModelArena arena(ArenaOptions{64 * 1024});
+    EXPECT_GE(arena.region_bytes(), 64u * 1024u);
+
+    std::vector<std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>> shard;
+    for (int i = 0; i < 16; ++i) {
+        shard.push_back(lib->create_realtime(cfg, arena.resource()));
+    }
+
+    std::vector<Real> e{static_cast<Real>(7)};
+    std::vector<Real> x{};
+    for (auto& m : shard) {
+        EXPECT_TRUE(arena.contains(m.get()));
+        m->ingest(Observation{TimePoint{}, e, x});
+        PredictionRequest req;
+        req.target_kind = TargetKind::Price;
+        EXPECT_DOUBLE_EQ(m->predict(req).mean[0], 7.0);
+    }
+    shard.clear();
+}
+
+TEST(ModelArenaTest, ResultsInPmrContainers) {
+    CountingResource mem;
+    std::pmr::vector<PredictionResult> results(&mem);
+
+    PredictionResult r;
+    r.mean.assign({1.0, 2.0});
+    r.emplace_variance(2, 0.5);
+    r.scalars["count"] = 3.0;
+    results.push_back(r);
+    results.push_back(std::move(r));
+
+    for (const auto& out : results) {
+        EXPECT_EQ(out.get_allocator().resource(), &mem);
+        ASSERT_TRUE(out.variance.has_value());
+        EXPECT_EQ(out.variance->get_allocator().resource(), &mem);
+        EXPECT_DOUBLE_EQ((*out.variance)[1], 0.5);
+        EXPECT_DOUBLE_EQ(out.scalars.at("count"), 3.0);
+    }
+    results.clear();
+    results.shrink_to_fit();
+    EXPECT_EQ(mem.live, 0u);
+}
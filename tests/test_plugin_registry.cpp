@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "KronosXPredict/plugin_registry.hpp"
+#include "KronosXPredict/memory.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using json = nlohmann::json;
+using namespace KronosXPredict;
+
+TEST(PluginRegistryTest, ScansManifestsAndCachesHandles) {
+    auto& reg = PluginRegistry::instance();
+    auto scanned = reg.scan("plugins/stub");
+    EXPECT_GE(scanned.registered, 1u);
+    EXPECT_TRUE(scanned.errors.empty());
+
+    auto m = reg.find("stub");
+    ASSERT_TRUE(m.has_value());
+    EXPECT_TRUE(m->compatible());
+    EXPECT_TRUE(m->provides_realtime);
+    EXPECT_TRUE(m->provides_realtime_pmr);
+    EXPECT_TRUE(m->provides_trainer);
+    EXPECT_EQ(m->precision, "float64");
+    EXPECT_FALSE(reg.find_by_kind(ModelKind::Custom).empty());
+    EXPECT_TRUE(reg.find_by_kind(ModelKind::Hawkes).empty());
+
+    // By name, by path and through load_plugin_library: one handle.
+    auto by_name = reg.library("stub");
+    auto by_path = load_plugin_library(m->library);
+    EXPECT_EQ(by_name, by_path);
+}
+
+TEST(PluginRegistryTest, RefusesIncompatibleAbi) {
+    namespace fs = std::filesystem;
+    const fs::path dir = "test_registry_old_abi";
+    fs::create_directories(dir);
+    {
+        std::ofstream out(dir / "old.manifest.json");
+        out << R"({"name": "old", "library": "libold.so", "abi_version": 0})";
+    }
+
+    auto& reg = PluginRegistry::instance();
+    EXPECT_EQ(reg.scan(dir.string()).registered, 1u);
+    ASSERT_TRUE(reg.find("old").has_value());
+    EXPECT_FALSE(reg.find("old")->compatible());
+    EXPECT_THROW(reg.library("old"), PluginError);
+
+    EXPECT_TRUE(reg.forget("old"));
+    EXPECT_FALSE(reg.find("old").has_value());
+    fs::remove_all(dir);
+}
+
+TEST(PluginRegistryTest, ScanSkipsBadManifests) {
+    namespace fs = std::filesystem;
+    const fs::path dir = "test_registry_bad_manifests";
+    fs::create_directories(dir);
+    {
+        std::ofstream(dir / "good.manifest.json")
+            << R"({"name": "good", "library": "libgood.so", "abi_version": 1})";
+        std::ofstream(dir / "broken.manifest.json") << "{ not json";
+        std::ofstream(dir / "kind.manifest.json")
+            << R"({"name": "kind", "library": "libkind.so", "model_kinds": ["Quantum"]})";
+    }
+
+    auto& reg = PluginRegistry::instance();
+    auto res = reg.scan(dir.string());
+    EXPECT_EQ(res.registered, 1u);
+    ASSERT_EQ(res.errors.size(), 2u);
+    EXPECT_TRUE(reg.find("good").has_value());
+    EXPECT_FALSE(reg.find("kind").has_value());
+
+    reg.forget("good");
+    fs::remove_all(dir);
+}
+
+TEST(PluginRegistryTest, WarmStartsModelsInParallel) {
+    auto& reg = PluginRegistry::instance();
+    reg.scan("plugins/stub");
+
+    std::vector<ModelSpec> specs;
+    for (int i = 0; i < 32; ++i) {
+        ModelSpec s;
+        s.plugin = "stub";
+        s.config = json{{"warmup_count", 2}};
+        s.warmup = [i](IRealtimeModel& m) {
+            std::vector<Real> e{static_cast<Real>(i)};
+            std::vector<Real> x{};
+            for (int k = 0; k < 2; ++k) {
+                m.ingest(Observation{TimePoint{}, e, x});
+            }
+        };
+        specs.push_back(std::move(s));
+    }
+    specs.push_back(ModelSpec{"no_such_plugin.so", json::object(), nullptr, nullptr});
+
+    auto res = reg.warm_start(specs, 4);
+    ASSERT_EQ(res.instances.size(), specs.size());
+    for (int i = 0; i < 32; ++i) {
+        ASSERT_TRUE(res.instances[i]) << res.errors[i];
+        EXPECT_TRUE(res.instances[i]->model().ready());
+        PredictionRequest req;
+        req.target_kind = TargetKind::Price;
+        EXPECT_DOUBLE_EQ(res.instances[i]->model().predict(req).mean[0], i);
+    }
+    EXPECT_FALSE(res.instances.back());
+    EXPECT_FALSE(res.errors.back().empty());
+    EXPECT_GE(res.timings.total, res.timings.create + res.timings.warmup);
+}
+
+TEST(PluginRegistryTest, WarmStartsIntoCallerResource) {
+    auto& reg = PluginRegistry::instance();
+    reg.scan("plugins/stub");
+
+    ArenaOptions opts;
+    opts.synchronized = true; // specs are created on several workers
+    ModelArena arena(opts);
+
+    std::vector<ModelSpec> specs;
+    for (int i = 0; i < 8; ++i) {
+        ModelSpec s;
+        s.plugin   = "stub";
+        s.config   = json{{"warmup_count", 1}};
+        s.resource = arena.resource();
+        specs.push_back(std::move(s));
+    }
+    specs.push_back(ModelSpec{"stub", json{{"warmup_count", 1}}, nullptr, nullptr});
+
+    auto res = reg.warm_start(specs, 4);
+    for (std::size_t i = 0; i + 1 < specs.size(); ++i) {
+        ASSERT_TRUE(res.instances[i]) << res.errors[i];
+        EXPECT_TRUE(arena.contains(&res.instances[i]->model()));
+    }
+    ASSERT_TRUE(res.instances.back()) << res.errors.back();
+    EXPECT_FALSE(arena.contains(&res.instances.back()->model()));
+
+    res.instances.clear(); // models go before their arena
+}
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "KronosXPredict/prediction_service.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+using namespace KronosXPredict;
+
+namespace {
+
+std::string stub_path() {
+#if defined(_WIN32)
+    return "plugins/stub/KronosXPredict_stub.dll";
+#elif defined(__APPLE__)
+    return "plugins/stub/libKronosXPredict_stub.dylib";
+#else
+    return "plugins/stub/libKronosXPredict_stub.so";
+#endif
+}
+
+std::shared_ptr<RealtimeModelInstance> make_stub_instance() {
+    auto lib = load_plugin_library(stub_path());
+    json cfg;
+    cfg["warmup_count"] = 1;
+    auto model = lib->create_realtime(cfg);
+    return std::make_shared<RealtimeModelInstance>(lib, std::move(model));
+}
+
+void ingest_values(PredictionService& svc, std::vector<Real> e) {
+    std::vector<Real> x{};
+    svc.ingest(Observation{
+        Clock::now(),
+        std::span<const Real>(e.data(), e.size()),
+        std::span<const Real>(x.data(), x.size())
+    });
+}
+
+// Predicts the last ingested value, blocking in predict() until opened.
+class GatedModel : public IRealtimeModel {
+public:
+    static std::atomic<bool> open;
+    static std::atomic<bool> entered;
+    static std::atomic<int>  hold; // TargetKind that blocks even when open, or -1
+
+    void ingest(const Observation& obs) override { last_ = obs.endogenous[0]; }
+    bool ready() const noexcept override { return true; }
+    PredictionResult predict(const PredictionRequest& req) const override {
+        entered = true;
+        while (!open || static_cast<int>(req.target_kind) == hold) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        PredictionResult r;
+        r.target_kind = req.target_kind;
+        r.mean.push_back(last_);
+        return r;
+    }
+    void reset() override {}
+    ModelKind kind() const noexcept override { return ModelKind::Custom; }
+
+private:
+    Real last_ = 0.0;
+};
+
+std::atomic<bool> GatedModel::open{true};
+std::atomic<bool> GatedModel::entered{false};
+std::atomic<int>  GatedModel::hold{-1};
+
+void destroy_gated(IRealtimeModel* m) { delete m; }
+
+std::shared_ptr<RealtimeModelInstance> make_gated_instance() {
+    return std::make_shared<RealtimeModelInstance>(
+        nullptr,
+        std::unique_ptr<IRealtimeModel, RealtimeDestroyFn>(new GatedModel, &destroy_gated));
+}
+
+// Closes the gate and submits a request that blocks the worker in predict().
+PredictionService::Future start_blocked(PredictionService& svc, const PredictionRequest& req) {
+    GatedModel::open = false;
+    GatedModel::entered = false;
+    auto f = svc.submit(req, std::chrono::seconds(10));
+    while (!GatedModel::entered) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return f;
+}
+
+} // namespace
+
+TEST(PredictionServiceTest, CoalescesIdenticalRequestsOnSameTick) {
+    PredictionService svc(make_stub_instance());
+    ingest_values(svc, {1.0, 2.0});
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Return;
+
+    std::vector<PredictionService::Future> futures;
+    std::vector<std::thread> threads;
+    std::mutex m;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            auto f = svc.submit(req, std::chrono::seconds(5));
+            std::lock_guard<std::mutex> lk(m);
+            futures.push_back(f);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    for (auto& f : futures) {
+        const auto& r = f.get();
+        ASSERT_EQ(r.mean.size(), 2u);
+        EXPECT_DOUBLE_EQ(r.mean[1], 2.0);
+    }
+
+    auto m1 = svc.metrics();
+    EXPECT_EQ(m1.submitted, 8u);
+    EXPECT_EQ(m1.computed, 1u);
+    EXPECT_EQ(m1.coalesced, 7u);
+
+    // A new tick invalidates the coalesced answer.
+    ingest_values(svc, {3.0, 4.0});
+    auto r = svc.submit(req, std::chrono::seconds(5)).get();
+    EXPECT_DOUBLE_EQ(r.mean[0], 3.0);
+    EXPECT_EQ(svc.metrics().computed, 2u);
+}
+
+TEST(PredictionServiceTest, MissedDeadlineIsShedOrServedStale) {
+    PredictionService svc(make_stub_instance());
+    ingest_values(svc, {1.0});
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Price;
+
+    auto expired = Clock::now() - std::chrono::milliseconds(1);
+    EXPECT_THROW(svc.submit(req, expired).get(), PredictionShed);
+    EXPECT_EQ(svc.metrics().shed, 1u);
+
+    svc.submit(req, std::chrono::seconds(5)).get();
+    ingest_values(svc, {2.0});
+
+    auto r = svc.submit(req, Clock::now() - std::chrono::milliseconds(1)).get();
+    EXPECT_DOUBLE_EQ(r.mean[0], 1.0);
+    EXPECT_DOUBLE_EQ(r.scalars.at("stale"), 1.0);
+    EXPECT_EQ(svc.metrics().served_stale, 1u);
+
+    PredictionServiceOptions opts;
+    opts.serve_stale = false;
+    PredictionService strict(make_stub_instance(), opts);
+    EXPECT_THROW(strict.submit(req, expired).get(), PredictionShed);
+}
+
+TEST(PredictionServiceTest, ShortDeadlineJoiningLongGroupKeepsItsDeadline) {
+    PredictionRequest req;
+    req.target_kind = TargetKind::Price;
+
+    {
+        PredictionService svc(make_gated_instance());
+        ingest_values(svc, {1.0});
+        svc.submit(req, std::chrono::seconds(5)).get();
+
+        ingest_values(svc, {2.0});
+        auto group = start_blocked(svc, req);
+
+        // Joins the in-flight tick with a much earlier deadline: answered now.
+        auto joiner = svc.submit(req, std::chrono::milliseconds(5));
+        ASSERT_EQ(joiner.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        EXPECT_DOUBLE_EQ(joiner.get().mean[0], 1.0);
+        EXPECT_DOUBLE_EQ(joiner.get().scalars.at("stale"), 1.0);
+
+        GatedModel::open = true;
+        EXPECT_DOUBLE_EQ(group.get().mean[0], 2.0);
+        EXPECT_EQ(svc.metrics().served_stale, 1u);
+    }
+    {
+        // Nothing to serve stale: the joiner keeps its own deadline and is shed.
+        PredictionServiceOptions opts;
+        opts.serve_stale = false;
+        PredictionService svc(make_gated_instance(), opts);
+        ingest_values(svc, {3.0});
+        auto group = start_blocked(svc, req);
+
+        // Shed at its deadline, while the worker is still blocked in predict().
+        auto joiner = svc.submit(req, std::chrono::milliseconds(5));
+        ASSERT_EQ(joiner.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+        GatedModel::open = true;
+
+        EXPECT_DOUBLE_EQ(group.get().mean[0], 3.0);
+        EXPECT_THROW(joiner.get(), PredictionShed);
+        auto m = svc.metrics();
+        EXPECT_EQ(m.computed, 1u);
+        EXPECT_EQ(m.shed, 1u);
+    }
+}
+
+TEST(PredictionServiceTest, LaterDeadlineJoinerSharesTheComputation) {
+    PredictionService svc(make_gated_instance());
+    ingest_values(svc, {4.0});
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Price;
+    auto group  = start_blocked(svc, req);
+    auto joiner = svc.submit(req, std::chrono::seconds(20));
+    GatedModel::open = true;
+
+    EXPECT_DOUBLE_EQ(group.get().mean[0], 4.0);
+    EXPECT_DOUBLE_EQ(joiner.get().mean[0], 4.0);
+    EXPECT_EQ(joiner.get().scalars.count("stale"), 0u);
+    auto m = svc.metrics();
+    EXPECT_EQ(m.computed, 1u);
+    EXPECT_EQ(m.coalesced, 1u);
+}
+
+TEST(PredictionServiceTest, DeadlineHoldsWhileModelIsBusy) {
+    PredictionServiceOptions opts;
+    opts.serve_stale = false;
+    PredictionService svc(make_gated_instance(), opts);
+    ingest_values(svc, {1.0});
+
+    PredictionRequest req;
+    req.target_kind = TargetKind::Price;
+    GatedModel::open = false;
+    GatedModel::entered = false;
+    auto f = svc.submit(req, std::chrono::milliseconds(20));
+    while (!GatedModel::entered) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_THROW(f.get(), PredictionShed);
+    GatedModel::open = true;
+
+    // The late result still lands in the cache for the next caller on this tick.
+    auto r = svc.submit(req, std::chrono::seconds(5)).get();
+    EXPECT_DOUBLE_EQ(r.mean[0], 1.0);
+    EXPECT_EQ(r.scalars.count("stale"), 0u);
+    EXPECT_EQ(svc.metrics().computed, 1u);
+}
+
+TEST(PredictionServiceTest, FreshResultWinsOverExpiredDeadline) {
+    PredictionServiceOptions opts;
+    opts.serve_stale = false;
+    PredictionService svc(make_gated_instance(), opts);
+    ingest_values(svc, {5.0});
+
+    PredictionRequest price;
+    price.target_kind = TargetKind::Price;
+    PredictionRequest ret;
+    ret.target_kind = TargetKind::Return;
+
+    auto group = start_blocked(svc, price);
+    auto other = svc.submit(ret, std::chrono::seconds(10));
+    // Queued behind `other` with its own, short deadline.
+    auto joiner = svc.submit(price, std::chrono::milliseconds(50));
+
+    // The price group completes; the worker then blocks on `other`.
+    GatedModel::hold = static_cast<int>(TargetKind::Return);
+    GatedModel::open = true;
+    EXPECT_DOUBLE_EQ(group.get().mean[0], 5.0);
+
+    // Past its deadline, but the answer for its tick is already cached.
+    ASSERT_EQ(joiner.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    const auto& r = joiner.get();
+    EXPECT_DOUBLE_EQ(r.mean[0], 5.0);
+    EXPECT_EQ(r.scalars.count("stale"), 0u);
+
+    GatedModel::hold = -1;
+    EXPECT_DOUBLE_EQ(other.get().mean[0], 5.0);
+    EXPECT_EQ(svc.metrics().shed, 0u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "KronosXPredict/training.hpp"
+#include "KronosXPredict/plugin.hpp"
+
+#include <cstring>
+
+using json = nlohmann::json;
+using namespace KronosXPredict;
+
+extern "C" IModelTrainer*
+KronosXPredict_create_trainer(const nlohmann::json& config);
+
+extern "C" void
+KronosXPredict_destroy_trainer(IModelTrainer* ptr);
+
+namespace {
+
+class VectorDataIterator : public ITrainingDataIterator {
+public:
+    explicit VectorDataIterator(const std::vector<TrainingSample>& samples)
+        : samples_(samples) {}
+
+    bool next(TrainingSample& out) override {
+        if (i_ == samples_.size()) return false;
+        out = samples_[i_++];
+        return true;
+    }
+    void reset() override { i_ = 0; }
+    std::size_t size_hint() const override { return samples_.size(); }
+
+private:
+    const std::vector<TrainingSample>& samples_;
+    std::size_t i_ = 0;
+};
+
+std::vector<Real> decode(const ParameterBlob& blob) {
+    std::vector<Real> out(blob.size() / sizeof(Real));
+    std::memcpy(out.data(), blob.data(), blob.size());
+    return out;
+}
+
+} // namespace
+
+TEST(StubTrainerTest, PartialFitMatchesFullFit) {
+    std::vector<std::vector<Real>> rows{{1.0, 10.0}, {2.0, 20.0}, {3.0, 30.0}, {6.0, 60.0}};
+    std::vector<TrainingSample> samples;
+    for (const auto& r : rows) {
+        samples.push_back(TrainingSample{
+            Observation{TimePoint{}, std::span<const Real>(r), std::span<const Real>()},
+            Target{std::span<const Real>(), TargetKind::Custom, 0}
+        });
+    }
+    TrainingConfig tcfg{ModelDefinition{ModelKind::Custom, 2, 0, {}}, {}};
+
+    std::unique_ptr<IModelTrainer, TrainerDestroyFn> full(
+        KronosXPredict_create_trainer(json::object()), KronosXPredict_destroy_trainer);
+    VectorDataIterator it(samples);
+    full->fit(it, tcfg);
+
+    std::unique_ptr<IModelTrainer, TrainerDestroyFn> online(
+        KronosXPredict_create_trainer(json::object()), KronosXPredict_destroy_trainer);
+    ASSERT_TRUE(online->supports_partial_fit());
+    online->partial_fit(std::span<const TrainingSample>(samples).first(3), tcfg);
+
+    // Resume from a checkpoint in a fresh trainer, then add the last batch.
+    std::unique_ptr<IModelTrainer, TrainerDestroyFn> resumed(
+        KronosXPredict_create_trainer(json::object()), KronosXPredict_destroy_trainer);
+    resumed->load_state(online->save_state());
+    resumed->partial_fit(std::span<const TrainingSample>(samples).subspan(3), tcfg);
+
+    EXPECT_EQ(resumed->parameters(), full->parameters());
+    EXPECT_DOUBLE_EQ(resumed->metrics().scalars.at("samples_seen"), 4.0);
+    auto mean = decode(full->parameters());
+    ASSERT_EQ(mean.size(), 2u);
+    EXPECT_DOUBLE_EQ(mean[0], 3.0);
+    EXPECT_DOUBLE_EQ(mean[1], 30.0);
+
+    EXPECT_THROW(resumed->load_state(TrainerState(3)), TrainingError);
+
+    // Well-sized blobs with a foreign magic or another layout version.
+    TrainerState foreign = online->save_state();
+    foreign[0] ^= std::byte{0xFF};
+    EXPECT_THROW(resumed->load_state(foreign), TrainingError);
+    TrainerState newer = online->save_state();
+    newer[4] = std::byte{2};
+    EXPECT_THROW(resumed->load_state(newer), TrainingError);
+}